@@ -0,0 +1,165 @@
+/*
+ * @file: bench_export.c
+ * @brief Throughput of status_export_step() against an snprintf baseline
+ *        producing the same JSON document.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#include "status.h"
+#include "status_export.h"
+
+#define ITERATIONS (20000u)
+#define OUT_MAX    (16384u)
+#define CHUNK      (64u)
+
+static const char *const class_key[3] = {"fault", "warning", "info"};
+static char names[3][NUM_STATUS_BANKS * NUM_STATUS_BITS][24];
+static char out[OUT_MAX];
+static volatile size_t sink;
+
+static const char *
+bench_name(enum status_class cls, uint16_t id)
+{
+        return names[cls][id];
+}
+
+static double
+now_s(void)
+{
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/* The snapshot + snprintf chain this module replaces. */
+static size_t
+baseline_json(bool with_names)
+{
+        uint16_t banks[NUM_STATUS_BANKS];
+        size_t len = 0u;
+
+        len += (size_t)snprintf(&out[len], OUT_MAX - len, "{");
+        for (int c = 0; c < 3; ++c) {
+                bool first = true;
+
+                status_snapshot((enum status_class)c, banks, NUM_STATUS_BANKS);
+                len += (size_t)snprintf(&out[len], OUT_MAX - len, "%s\"%s\":[",
+                                        (c != 0) ? "," : "", class_key[c]);
+                for (unsigned id = 0u; id < NUM_STATUS_BANKS * NUM_STATUS_BITS;
+                     ++id) {
+                        if ((banks[id / 16u] & (1u << (id % 16u))) == 0u) {
+                                continue;
+                        }
+                        if (with_names) {
+                                len += (size_t)snprintf(
+                                    &out[len], OUT_MAX - len,
+                                    "%s{\"id\":%u,\"name\":\"%s\"}",
+                                    first ? "" : ",", id, names[c][id]);
+                        } else {
+                                len += (size_t)snprintf(&out[len],
+                                                        OUT_MAX - len, "%s%u",
+                                                        first ? "" : ",", id);
+                        }
+                        first = false;
+                }
+                len += (size_t)snprintf(&out[len], OUT_MAX - len, "]");
+        }
+        len += (size_t)snprintf(&out[len], OUT_MAX - len, "}");
+
+        return len;
+}
+
+static size_t
+stream(enum status_export_format fmt, bool with_names)
+{
+        struct status_exporter x;
+        size_t len = 0u;
+        size_t off = 0u;
+
+        status_export_begin(&x, fmt, with_names ? bench_name : NULL);
+        while (!status_export_done(&x)) {
+                const size_t n =
+                    status_export_step(&x, (uint8_t *)&out[off], CHUNK);
+
+                /* Pretend each chunk was handed to a transport. */
+                off = ((off + n) > (OUT_MAX - CHUNK)) ? 0u : (off + n);
+                len += n;
+        }
+
+        return len;
+}
+
+static void
+report(const char *label, double secs, size_t bytes)
+{
+        fprintf(stdout, "%-28s %8.1f ns/doc %8.1f MB/s\n", label,
+                (secs * 1e9) / ITERATIONS,
+                ((double)bytes * ITERATIONS) / (secs * 1e6));
+}
+
+int
+main(void)
+{
+        status_init();
+        for (uint16_t c = 0u; c < 3u; ++c) {
+                for (uint16_t id = 0u; id < NUM_STATUS_BANKS * NUM_STATUS_BITS;
+                     ++id) {
+                        snprintf(names[c][id], sizeof(names[c][id]),
+                                 "%s_%u", class_key[c], id);
+                }
+        }
+        /* Roughly a quarter of all IDs active. */
+        for (uint16_t id = 0u; id < NUM_STATUS_BANKS * NUM_STATUS_BITS;
+             id = (uint16_t)(id + 4u)) {
+                status_set_fault(id);
+                status_set_warning((uint16_t)(id + 1u));
+                status_set_info((uint16_t)(id + 2u));
+        }
+
+        for (int n = 0; n < 2; ++n) {
+                const bool with_names = (n != 0);
+                double t0;
+                size_t bytes = 0u;
+
+                t0 = now_s();
+                for (unsigned i = 0u; i < ITERATIONS; ++i) {
+                        bytes = baseline_json(with_names);
+                        sink = bytes;
+                }
+                report(with_names ? "snprintf json+names" : "snprintf json",
+                       now_s() - t0, bytes);
+
+                t0 = now_s();
+                for (unsigned i = 0u; i < ITERATIONS; ++i) {
+                        bytes = stream(STATUS_EXPORT_JSON, with_names);
+                        sink = bytes;
+                }
+                report(with_names ? "status_export json+names"
+                                  : "status_export json",
+                       now_s() - t0, bytes);
+
+                t0 = now_s();
+                for (unsigned i = 0u; i < ITERATIONS; ++i) {
+                        bytes = stream(STATUS_EXPORT_CBOR, with_names);
+                        sink = bytes;
+                }
+                report(with_names ? "status_export cbor+names"
+                                  : "status_export cbor",
+                       now_s() - t0, bytes);
+        }
+
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,23 @@
+/*
+ * @file: bench_hpp_lock.c
+ * @brief The library as timed by bench_hpp: status.c built in with a
+ *        C11 atomic_flag spinlock as its critical section.
+ *
+ * @details
+ *    Uncontended, each locked call costs one acquire test-and-set and one
+ *    release store, the closest C counterpart of the typed register's
+ *    single acq_rel read-modify-write.
+ */
+
+#include <stdatomic.h>
+
+static atomic_flag status_lock = ATOMIC_FLAG_INIT;
+
+#define STATUS_ENTER_CRITICAL()                                                \
+        do {                                                                   \
+        } while (atomic_flag_test_and_set_explicit(&status_lock,               \
+                                                   memory_order_acquire))
+#define STATUS_EXIT_CRITICAL()                                                 \
+        atomic_flag_clear_explicit(&status_lock, memory_order_release)
+
+#include "../src/status.c"
@@ -0,0 +1,213 @@
+/*
+ * @file: bench_replay.c
+ * @brief Replay driver and realistic-workload throughput benchmark.
+ *
+ * @details
+ *    usage: bench_replay [-t us_per_tick] [FILE]
+ *
+ *    With FILE, replays that recording (full speed, or paced at
+ *    `us_per_tick` microseconds per recorded tick) and checks its
+ *    checkpoints. Without FILE, records a synthetic workload in memory and
+ *    measures how fast it replays through set/clear.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#include "status.h"
+#include "status_record.h"
+#include "status_replay.h"
+
+#define SYNTH_EVENTS      (4000000u)
+#define SYNTH_CHECKPOINTS (1000u)
+
+static double
+now_s(void)
+{
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static void
+paced_wait(status_time_t delta, void *ctx)
+{
+        const unsigned long us = (unsigned long)delta * *(unsigned long *)ctx;
+        struct timespec ts = {
+                .tv_sec = (time_t)(us / 1000000u),
+                .tv_nsec = (long)((us % 1000000u) * 1000u),
+        };
+
+        if (us != 0u) {
+                nanosleep(&ts, NULL);
+        }
+}
+
+/*
+ * Record a synthetic session: a few hot IDs chatter, the rest toggle
+ * rarely, with an occasional clear_all and regular checkpoints.
+ */
+static uint8_t *
+synthesize(size_t *len)
+{
+        const size_t n = SYNTH_EVENTS + SYNTH_CHECKPOINTS;
+        uint8_t *buf = malloc(STATUS_REC_HDR_SIZE + (n * STATUS_REC_SIZE));
+        uint8_t *p = buf + STATUS_REC_HDR_SIZE;
+        uint32_t seed = 1u;
+
+        if (buf == NULL) {
+                return NULL;
+        }
+        status_rec_header_pack(buf, (uint16_t)NUM_STATUS_BANKS);
+        status_init();
+
+        for (uint32_t i = 0u; i < SYNTH_EVENTS; ++i) {
+                struct status_record r = {.time = i * 3u};
+
+                seed = (seed * 1103515245u) + 12345u;
+                const uint32_t rnd = seed >> 8u;
+                const uint32_t ids = NUM_STATUS_BANKS * NUM_STATUS_BITS;
+
+                r.cls = (uint8_t)(rnd % 3u);
+                r.id = (uint16_t)(((rnd & 0x300u) != 0u) ? ((rnd >> 10u) % 8u)
+                                                         : ((rnd >> 10u) % ids));
+                r.op = (uint8_t)(((rnd >> 4u) & 1u) ? STATUS_REC_SET
+                                                    : STATUS_REC_CLEAR);
+                if ((rnd % 50000u) == 0u) {
+                        r.op = STATUS_REC_CLEAR_ALL;
+                        r.id = 0u;
+                }
+                switch (r.op) {
+                case STATUS_REC_SET:
+                        if (r.cls == 0u) {
+                                status_set_fault(r.id);
+                        } else if (r.cls == 1u) {
+                                status_set_warning(r.id);
+                        } else {
+                                status_set_info(r.id);
+                        }
+                        break;
+                case STATUS_REC_CLEAR:
+                        if (r.cls == 0u) {
+                                status_clear_fault(r.id);
+                        } else if (r.cls == 1u) {
+                                status_clear_warning(r.id);
+                        } else {
+                                status_clear_info(r.id);
+                        }
+                        break;
+                default:
+                        status_clear_all((enum status_class)r.cls);
+                        break;
+                }
+                status_record_pack(p, &r);
+                p += STATUS_REC_SIZE;
+
+                if (((i + 1u) % (SYNTH_EVENTS / SYNTH_CHECKPOINTS)) == 0u) {
+                        const struct status_record cp = {
+                                .time = r.time,
+                                .op = STATUS_REC_CHECKPOINT,
+                                .value = status_replay_checkpoint(),
+                        };
+
+                        status_record_pack(p, &cp);
+                        p += STATUS_REC_SIZE;
+                }
+        }
+
+        *len = (size_t)(p - buf);
+        return buf;
+}
+
+static int
+report(const struct status_replay_result *res, double secs)
+{
+        fprintf(stdout,
+                "%zu records, %zu checkpoints, %zu mismatches, %zu invalid\n"
+                "%.3f s, %.2f M records/s\n",
+                res->events, res->checkpoints, res->mismatches, res->invalid,
+                secs, ((double)res->events / secs) * 1e-6);
+        if (res->mismatches != 0u) {
+                fprintf(stdout, "first mismatch at record %zu\n",
+                        res->first_mismatch);
+                return 2;
+        }
+        return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+        unsigned long us_per_tick = 0u;
+        struct status_replay_result res;
+        int opt;
+
+        while ((opt = getopt(argc, argv, "t:")) != -1) {
+                if (opt != 't') {
+                        fprintf(stderr,
+                                "usage: bench_replay [-t us_per_tick] [FILE]\n");
+                        return 1;
+                }
+                us_per_tick = strtoul(optarg, NULL, 0);
+        }
+
+        if (optind < argc) {
+                int fd = open(argv[optind], O_RDONLY);
+                struct stat st;
+
+                if ((fd < 0) || (fstat(fd, &st) != 0) || (st.st_size == 0)) {
+                        perror(argv[optind]);
+                        return 1;
+                }
+                const size_t len = (size_t)st.st_size;
+                const uint8_t *map =
+                    mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+                close(fd);
+                if (map == MAP_FAILED) {
+                        perror("mmap");
+                        return 1;
+                }
+
+                status_init();
+                const double t0 = now_s();
+                if (!status_replay(map, len,
+                                   (us_per_tick != 0u) ? paced_wait : NULL,
+                                   &us_per_tick, &res)) {
+                        fprintf(stderr, "%s: not a recording for %u banks\n",
+                                argv[optind], (unsigned)NUM_STATUS_BANKS);
+                        return 1;
+                }
+                const int rc = report(&res, now_s() - t0);
+                munmap((void *)map, len);
+                return rc;
+        }
+
+        size_t len = 0u;
+        uint8_t *buf = synthesize(&len);
+
+        if (buf == NULL) {
+                return 1;
+        }
+        status_init();
+        const double t0 = now_s();
+        (void)status_replay(buf, len, NULL, NULL, &res);
+        const int rc = report(&res, now_s() - t0);
+        free(buf);
+
+        return rc;
+}
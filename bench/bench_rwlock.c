@@ -0,0 +1,150 @@
+/*
+ * @file: bench_rwlock.c
+ * @brief Query/update throughput with an exclusive lock versus a
+ *        reader/writer split, across read/write ratios.
+ *
+ * @details
+ *    usage: bench_rwlock [-t threads] [-n ops_per_thread]
+ *
+ *    Builds the library in with both critical-section pairs mapped onto one
+ *    pthread_rwlock_t. Writers always take the write lock; readers take the
+ *    write lock in "exclusive" mode (the STATUS_ENTER_READ() default) and
+ *    the read lock in "shared" mode.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+static pthread_rwlock_t status_lock = PTHREAD_RWLOCK_INITIALIZER;
+static bool shared_reads;
+
+#define STATUS_ENTER_CRITICAL() (void)pthread_rwlock_wrlock(&status_lock)
+#define STATUS_EXIT_CRITICAL()  (void)pthread_rwlock_unlock(&status_lock)
+#define STATUS_ENTER_READ()                                                    \
+        (void)(shared_reads ? pthread_rwlock_rdlock(&status_lock)              \
+                            : pthread_rwlock_wrlock(&status_lock))
+#define STATUS_EXIT_READ() (void)pthread_rwlock_unlock(&status_lock)
+
+#include "../src/status.c"
+
+#define MAX_THREADS (64u)
+
+struct worker {
+        pthread_t thread;
+        uint32_t seed;
+        unsigned int read_pct;
+        unsigned long ops;
+        unsigned long hits;
+};
+
+static double
+now_s(void)
+{
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static void *
+work(void *arg)
+{
+        struct worker *w = arg;
+        const uint32_t ids = NUM_STATUS_BANKS * NUM_STATUS_BITS;
+
+        for (unsigned long i = 0u; i < w->ops; ++i) {
+                w->seed = (w->seed * 1103515245u) + 12345u;
+                const uint32_t rnd = w->seed >> 8u;
+                const uint16_t id = (uint16_t)((rnd >> 8u) % ids);
+
+                if ((rnd % 100u) < w->read_pct) {
+                        /* Mirror a query-heavy profile: mostly point reads. */
+                        if ((rnd & 0xF0000u) == 0u) {
+                                w->hits += status_any(STATUS_CLASS_FAULT);
+                        } else {
+                                w->hits += status_is_fault_set(id);
+                        }
+                } else if ((rnd & 0x10000u) != 0u) {
+                        status_set_fault(id);
+                } else {
+                        status_clear_fault(id);
+                }
+        }
+
+        return NULL;
+}
+
+static double
+run(unsigned int threads, unsigned int read_pct, unsigned long ops,
+    bool shared)
+{
+        struct worker w[MAX_THREADS];
+
+        shared_reads = shared;
+        status_init();
+
+        const double t0 = now_s();
+        for (unsigned int t = 0u; t < threads; ++t) {
+                w[t] = (struct worker){
+                        .seed = t + 1u,
+                        .read_pct = read_pct,
+                        .ops = ops,
+                };
+                if (pthread_create(&w[t].thread, NULL, work, &w[t]) != 0) {
+                        perror("pthread_create");
+                        exit(EXIT_FAILURE);
+                }
+        }
+        for (unsigned int t = 0u; t < threads; ++t) {
+                (void)pthread_join(w[t].thread, NULL);
+        }
+        const double secs = now_s() - t0;
+
+        return ((double)threads * (double)ops / secs) * 1e-6;
+}
+
+int
+main(int argc, char **argv)
+{
+        static const unsigned int ratios[] = {0u, 50u, 90u, 95u, 99u, 100u};
+        unsigned int threads = 4u;
+        unsigned long ops = 1000000u;
+        int opt;
+
+        while ((opt = getopt(argc, argv, "t:n:")) != -1) {
+                if (opt == 't') {
+                        threads = (unsigned int)strtoul(optarg, NULL, 0);
+                } else if (opt == 'n') {
+                        ops = strtoul(optarg, NULL, 0);
+                } else {
+                        fprintf(stderr,
+                                "usage: bench_rwlock [-t threads] "
+                                "[-n ops_per_thread]\n");
+                        return 1;
+                }
+        }
+        if ((threads == 0u) || (threads > MAX_THREADS)) {
+                fprintf(stderr, "threads must be 1..%u\n", MAX_THREADS);
+                return 1;
+        }
+
+        fprintf(stdout, "%u threads, %lu ops each (M ops/s)\n", threads, ops);
+        fprintf(stdout, "read%%  exclusive  shared  speedup\n");
+        for (size_t i = 0u; i < (sizeof(ratios) / sizeof(ratios[0])); ++i) {
+                const double ex = run(threads, ratios[i], ops, false);
+                const double sh = run(threads, ratios[i], ops, true);
+
+                fprintf(stdout, "%5u  %9.2f  %6.2f  %6.2fx\n", ratios[i], ex,
+                        sh, sh / ex);
+        }
+
+        return 0;
+}
@@ -0,0 +1,566 @@
+/*
+ * @file: bench_wcet.c
+ * @brief Execution-time harness for the public API.
+ *
+ * @details
+ *    usage: bench_wcet [-w warm_samples] [-c cold_samples]
+ *
+ *    Each API is driven into its worst-case path (the longest scan, every
+ *    hook firing) and timed with the cycle counter, once per sample, under
+ *    two conditions:
+ *
+ *      warm  the same call repeated back to back;
+ *      cold  WCET_EVICT_BYTES of unrelated memory is written before every
+ *            sample to push the library's code and data out of the caches.
+ *
+ *    The harness is compiled once per NUM_STATUS_BANKS and feature set (see
+ *    bench/meson.build). It reports p50, p99, p99.9 and maximum in counter
+ *    ticks; the timer overhead is measured and subtracted. Host figures are
+ *    evidence of the algorithmic worst case, not target WCET: rebuild with
+ *    WCET_CYCLES() mapped to the target's cycle counter (e.g. DWT->CYCCNT)
+ *    for that.
+ */
+
+/* Usually set on the command line, ahead of the force-included config. */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "status.h"
+#include "status_deadline.h"
+
+#ifndef WCET_CYCLES
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+/* lfence keeps rdtsc from being reordered around the measured call. */
+static inline uint64_t
+wcet_cycles(void)
+{
+        _mm_lfence();
+        const uint64_t t = __rdtsc();
+        _mm_lfence();
+        return t;
+}
+#define WCET_UNIT "tsc ticks"
+#elif defined(__aarch64__)
+static inline uint64_t
+wcet_cycles(void)
+{
+        uint64_t t;
+
+        __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(t) : : "memory");
+        return t;
+}
+#define WCET_UNIT "cntvct ticks"
+#else
+static inline uint64_t
+wcet_cycles(void)
+{
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+#define WCET_UNIT "ns"
+#endif
+#define WCET_CYCLES() wcet_cycles()
+#endif
+
+#ifndef WCET_UNIT
+#define WCET_UNIT "cycles"
+#endif
+
+/* Larger than the last-level cache of the hosts we run on. */
+#ifndef WCET_EVICT_BYTES
+#define WCET_EVICT_BYTES (64u * 1024u * 1024u)
+#endif
+
+#define LAST_ID STATUS_ENCODE(NUM_STATUS_BANKS - 1u, 15u)
+
+#if STATUS_ENABLE_TIME_IN_STATE || STATUS_ENABLE_HISTOGRAM                    \
+    || STATUS_ENABLE_PRIORITY || STATUS_ENABLE_INTEGRITY                      \
+    || STATUS_ENABLE_SHADOW || STATUS_ENABLE_SOURCES                          \
+    || STATUS_ENABLE_BANK_ALLOC
+#define WCET_CONFIG "features"
+#else
+#define WCET_CONFIG "base"
+#endif
+
+struct wcet_case {
+        const char *name;
+        void (*setup)(void); /* restore the worst-case state, untimed */
+        void (*op)(void);    /* the measured call */
+};
+
+volatile uint32_t wcet_clock;
+
+static uint8_t *evict_buf;
+static uint64_t *samples;
+static uint16_t snap[NUM_STATUS_BANKS];
+/* One term per bank, selecting the bit setup_all_banks() sets there. */
+static struct status_query_term terms[NUM_STATUS_BANKS];
+static volatile uint32_t sink;
+static uint64_t overhead;
+
+/* ---------------- setups ---------------- */
+
+static void
+setup_none(void)
+{
+}
+
+static void
+setup_clear_last(void)
+{
+        status_clear_fault(LAST_ID);
+}
+
+static void
+setup_set_last(void)
+{
+        status_set_fault(LAST_ID);
+}
+
+/* status_any() and the scans only find the last bank. */
+static void
+setup_only_last(void)
+{
+        status_clear_all(STATUS_CLASS_FAULT);
+        status_set_fault(LAST_ID);
+}
+
+/* Every bank non-zero, so clear_all fires the hooks for each one. */
+static void
+setup_all_banks(void)
+{
+        for (uint16_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                status_set_fault(STATUS_ENCODE(b, (uint16_t)(b % 16u)));
+        }
+}
+
+/* Only the last term of `terms` matches, so status_query_any() reads all. */
+static void
+setup_query_last(void)
+{
+        status_clear_all(STATUS_CLASS_FAULT);
+        status_set_fault(STATUS_ENCODE(NUM_STATUS_BANKS - 1u,
+                                       (NUM_STATUS_BANKS - 1u) % 16u));
+}
+
+/*
+ * Every warning term holds and the fault is clear: status_set_if() with
+ * STATUS_COND_ALL reads every bank, then sets.
+ */
+static void
+setup_cond_all(void)
+{
+        for (uint16_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                status_set_warning(STATUS_ENCODE(b, (uint16_t)(b % 16u)));
+        }
+        status_clear_fault(LAST_ID);
+}
+
+/*
+ * No warning is set and the fault is: status_clear_unless() with
+ * STATUS_COND_ANY reads every bank, then clears.
+ */
+static void
+setup_cond_none(void)
+{
+        status_clear_all(STATUS_CLASS_WARNING);
+        status_set_fault(LAST_ID);
+}
+
+/* Every deadline slot expires on the next tick. */
+static void
+setup_deadlines(void)
+{
+        status_deadline_init();
+        wcet_clock = 0u;
+        for (uint16_t i = 0u; i < STATUS_DEADLINE_MAX; ++i) {
+                (void)status_deadline_register(
+                    STATUS_CLASS_FAULT,
+                    STATUS_ENCODE(i % NUM_STATUS_BANKS, (uint16_t)(i % 16u)),
+                    (status_time_t)(i + 1u), 0u);
+        }
+}
+
+/* ---------------- measured calls ---------------- */
+
+static void
+op_set(void)
+{
+        status_set_fault(LAST_ID);
+}
+
+static void
+op_clear(void)
+{
+        status_clear_fault(LAST_ID);
+}
+
+static void
+op_is_set(void)
+{
+        sink = status_is_fault_set(LAST_ID);
+}
+
+static void
+op_any(void)
+{
+        sink = status_any(STATUS_CLASS_FAULT);
+}
+
+static void
+op_clear_all(void)
+{
+        status_clear_all(STATUS_CLASS_FAULT);
+}
+
+static void
+op_snapshot(void)
+{
+        status_snapshot(STATUS_CLASS_FAULT, snap, NUM_STATUS_BANKS);
+}
+
+static void
+op_last(void)
+{
+        sink = status_last_fault();
+}
+
+static void
+op_invalid(void)
+{
+        status_set_fault(STATUS_UNSET_ID);
+}
+
+static void
+op_field_count(void)
+{
+        sink = (uint32_t)status_field_count_at_least(
+            STATUS_CLASS_FAULT, 0u, NUM_STATUS_BANKS, 2u, 3u);
+}
+
+static void
+op_query_any(void)
+{
+        sink = status_query_any(STATUS_CLASS_FAULT, terms, NUM_STATUS_BANKS);
+}
+
+static void
+op_query_all(void)
+{
+        sink = status_query_all(STATUS_CLASS_FAULT, terms, NUM_STATUS_BANKS);
+}
+
+static void
+op_query_collect(void)
+{
+        sink = (uint32_t)status_query_collect(STATUS_CLASS_FAULT, terms,
+                                              NUM_STATUS_BANKS, snap);
+}
+
+static void
+op_set_if(void)
+{
+        const struct status_cond cond = {
+                STATUS_CLASS_WARNING, terms, NUM_STATUS_BANKS, STATUS_COND_ALL,
+        };
+
+        sink = status_set_if(STATUS_CLASS_FAULT, LAST_ID, &cond);
+}
+
+static void
+op_clear_unless(void)
+{
+        const struct status_cond cond = {
+                STATUS_CLASS_WARNING, terms, NUM_STATUS_BANKS, STATUS_COND_ANY,
+        };
+
+        sink = status_clear_unless(STATUS_CLASS_FAULT, LAST_ID, &cond);
+}
+
+static void
+op_init(void)
+{
+        status_init();
+}
+
+static void
+op_deadline_tick(void)
+{
+        sink = (uint32_t)status_deadline_tick(STATUS_DEADLINE_MAX + 1u);
+}
+
+#if STATUS_ENABLE_PRIORITY
+static void
+setup_prio(void)
+{
+        setup_only_last();
+        status_set_priority(STATUS_CLASS_FAULT, LAST_ID, 0u);
+}
+
+static void
+op_highest(void)
+{
+        sink = status_highest_active(STATUS_CLASS_FAULT);
+}
+#endif
+
+#if STATUS_ENABLE_TIME_IN_STATE
+static status_time_t tis[NUM_STATUS_BANKS * NUM_STATUS_BITS];
+
+static void
+op_time_in_state(void)
+{
+        status_time_in_state(STATUS_CLASS_FAULT, tis,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+}
+#endif
+
+#if STATUS_ENABLE_INTEGRITY
+static void
+op_verify(void)
+{
+        sink = status_verify(STATUS_CLASS_FAULT);
+}
+
+static void
+op_verify_pass(void)
+{
+        sink = status_verify_step(STATUS_CLASS_FAULT, NUM_STATUS_BANKS);
+}
+#endif
+
+#if STATUS_ENABLE_SHADOW
+static void
+op_scrub_all(void)
+{
+        sink = (uint32_t)status_scrub_step(3u * NUM_STATUS_BANKS);
+}
+#endif
+
+#if STATUS_ENABLE_BANK_ALLOC
+#define ALLOC_SPAN (NUM_STATUS_BANKS - STATUS_BANK_ALLOC_FIRST)
+
+/*
+ * Single-bank holes up to the last two banks, which are the only run that
+ * fits two banks: first fit visits every hole.
+ */
+static void
+setup_alloc_last(void)
+{
+        status_init();
+        for (uint32_t i = 0u; i < ALLOC_SPAN; ++i) {
+                (void)status_bank_alloc(1u, 1u);
+        }
+        for (uint32_t i = 0u; (i + 3u) < ALLOC_SPAN; i += 2u) {
+                status_bank_free((uint16_t)(STATUS_BANK_ALLOC_FIRST + i), 1u,
+                                 1u);
+        }
+        if (ALLOC_SPAN >= 2u) {
+                status_bank_free((uint16_t)(NUM_STATUS_BANKS - 2u), 2u, 1u);
+        }
+}
+
+static void
+op_bank_alloc(void)
+{
+        sink = status_bank_alloc(2u, 1u);
+}
+
+/* One range over every managed bank, with every bank of every class set. */
+static void
+setup_free_all(void)
+{
+        status_init();
+        (void)status_bank_alloc((uint16_t)ALLOC_SPAN, 1u);
+        for (uint16_t b = STATUS_BANK_ALLOC_FIRST; b < NUM_STATUS_BANKS; ++b) {
+                status_set_fault(STATUS_ENCODE(b, 0u));
+                status_set_warning(STATUS_ENCODE(b, 0u));
+                status_set_info(STATUS_ENCODE(b, 0u));
+        }
+}
+
+static void
+op_bank_free(void)
+{
+        status_bank_free(STATUS_BANK_ALLOC_FIRST, (uint16_t)ALLOC_SPAN, 1u);
+}
+#endif
+
+#if STATUS_ENABLE_SOURCES
+static void
+setup_source(void)
+{
+        status_source_set(STATUS_CLASS_FAULT, LAST_ID, 0u);
+}
+
+static void
+op_source_clear(void)
+{
+        status_source_clear(STATUS_CLASS_FAULT, LAST_ID, 0u);
+}
+#endif
+
+static const struct wcet_case cases[] = {
+        {"set_fault (edge, last bank)", setup_clear_last, op_set},
+        {"clear_fault (edge, last bank)", setup_set_last, op_clear},
+        {"is_fault_set (last bank)", setup_set_last, op_is_set},
+        {"any (only last bank set)", setup_only_last, op_any},
+        {"clear_all (every bank set)", setup_all_banks, op_clear_all},
+        {"snapshot (all banks)", setup_all_banks, op_snapshot},
+        {"last_fault", setup_none, op_last},
+        {"set_fault (invalid ID)", setup_none, op_invalid},
+        {"field_count_at_least (all banks)", setup_all_banks, op_field_count},
+        {"query_any (hit in last bank)", setup_query_last, op_query_any},
+        {"query_all (all banks)", setup_all_banks, op_query_all},
+        {"query_collect (all banks)", setup_all_banks, op_query_collect},
+        {"set_if (ALL over all banks)", setup_cond_all, op_set_if},
+        {"clear_unless (ANY, none set)", setup_cond_none, op_clear_unless},
+        {"init", setup_all_banks, op_init},
+        {"deadline_tick (all expire)", setup_deadlines, op_deadline_tick},
+#if STATUS_ENABLE_PRIORITY
+        {"highest_active", setup_prio, op_highest},
+#endif
+#if STATUS_ENABLE_TIME_IN_STATE
+        {"time_in_state (all IDs)", setup_all_banks, op_time_in_state},
+#endif
+#if STATUS_ENABLE_INTEGRITY
+        {"verify", setup_none, op_verify},
+        {"verify_step (full pass)", setup_all_banks, op_verify_pass},
+#endif
+#if STATUS_ENABLE_SHADOW
+        {"scrub_step (all banks)", setup_all_banks, op_scrub_all},
+#endif
+#if STATUS_ENABLE_SOURCES
+        {"source_clear (last source)", setup_source, op_source_clear},
+#endif
+#if STATUS_ENABLE_BANK_ALLOC
+        {"bank_alloc (last run free)", setup_alloc_last, op_bank_alloc},
+        {"bank_free (all banks set)", setup_free_all, op_bank_free},
+#endif
+};
+
+static void
+evict(void)
+{
+        for (size_t i = 0u; i < WCET_EVICT_BYTES; i += 64u) {
+                evict_buf[i]++;
+        }
+}
+
+static int
+cmp_u64(const void *a, const void *b)
+{
+        const uint64_t x = *(const uint64_t *)a;
+        const uint64_t y = *(const uint64_t *)b;
+
+        return (x > y) - (x < y);
+}
+
+static uint64_t
+pct(const uint64_t *s, size_t n, unsigned int per_mille)
+{
+        return s[((n - 1u) * per_mille) / 1000u];
+}
+
+static void
+measure(const struct wcet_case *c, size_t n, bool cold)
+{
+        for (size_t i = 0u; i < n; ++i) {
+                c->setup();
+                if (cold) {
+                        evict();
+                }
+                const uint64_t t0 = WCET_CYCLES();
+                c->op();
+                const uint64_t t1 = WCET_CYCLES();
+                const uint64_t d = t1 - t0;
+
+                samples[i] = (d > overhead) ? (d - overhead) : 0u;
+        }
+        qsort(samples, n, sizeof(samples[0]), cmp_u64);
+        fprintf(stdout, "%-32s %-4s %8llu %8llu %8llu %8llu\n", c->name,
+                cold ? "cold" : "warm",
+                (unsigned long long)pct(samples, n, 500u),
+                (unsigned long long)pct(samples, n, 990u),
+                (unsigned long long)pct(samples, n, 999u),
+                (unsigned long long)samples[n - 1u]);
+}
+
+static void
+calibrate(size_t n)
+{
+        for (size_t i = 0u; i < n; ++i) {
+                const uint64_t t0 = WCET_CYCLES();
+                const uint64_t t1 = WCET_CYCLES();
+
+                samples[i] = t1 - t0;
+        }
+        qsort(samples, n, sizeof(samples[0]), cmp_u64);
+        overhead = samples[0];
+}
+
+int
+main(int argc, char **argv)
+{
+        size_t warm = 10000u;
+        size_t cold = 200u;
+        int opt;
+
+        while ((opt = getopt(argc, argv, "w:c:")) != -1) {
+                if (opt == 'w') {
+                        warm = strtoul(optarg, NULL, 0);
+                } else if (opt == 'c') {
+                        cold = strtoul(optarg, NULL, 0);
+                } else {
+                        fprintf(stderr, "usage: bench_wcet [-w warm_samples] "
+                                        "[-c cold_samples]\n");
+                        return 1;
+                }
+        }
+        if ((warm == 0u) || (cold == 0u)) {
+                fprintf(stderr, "sample counts must be non-zero\n");
+                return 1;
+        }
+
+        evict_buf = calloc(WCET_EVICT_BYTES, 1u);
+        samples = malloc(((warm > cold) ? warm : cold) * sizeof(samples[0]));
+        if ((evict_buf == NULL) || (samples == NULL)) {
+                perror("bench_wcet");
+                return 1;
+        }
+
+        status_init();
+        status_deadline_init();
+        for (uint16_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                terms[b].bank = b;
+                terms[b].mask = (uint16_t)(1u << (b % 16u));
+        }
+        calibrate(warm);
+
+        fprintf(stdout, "NUM_STATUS_BANKS=%u config=%s unit=%s overhead=%llu\n",
+                (unsigned)NUM_STATUS_BANKS, WCET_CONFIG, WCET_UNIT,
+                (unsigned long long)overhead);
+        fprintf(stdout, "%-32s %-4s %8s %8s %8s %8s\n", "api", "", "p50",
+                "p99", "p99.9", "max");
+        for (size_t k = 0u; k < (sizeof(cases) / sizeof(cases[0])); ++k) {
+                measure(&cases[k], warm, false);
+                measure(&cases[k], cold, true);
+        }
+
+        free(samples);
+        free(evict_buf);
+        return 0;
+}
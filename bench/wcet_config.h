@@ -0,0 +1,21 @@
+/*
+ * @file: wcet_config.h
+ * @brief Platform hooks for the WCET harness. Force-included ahead of the
+ *        library sources and bench_wcet.c.
+ */
+
+#ifndef WCET_CONFIG_H
+#define WCET_CONFIG_H
+
+#include <stdint.h>
+
+/* Clock advanced by the harness. */
+extern volatile uint32_t wcet_clock;
+
+/* Measured without locking; add the cost of your own macros. */
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#define STATUS_TIME_NOW() (wcet_clock)
+
+#endif /* WCET_CONFIG_H */
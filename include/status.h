@@ -58,6 +58,257 @@ extern "C" {
  */
 #define STATUS_UNSET_ID (0xFFFFu)
 
+/* ---------------  Optional Features --------------------------------------- */
+
+/**
+ * @def STATUS_ENABLE_TIME_IN_STATE
+ * @brief Accumulate the total time each status ID has spent active.
+ *
+ * @details
+ *    Accumulators are updated only on set/clear edges; the open interval of
+ *    active IDs is added when read with status_time_in_state(), so there is
+ *    no periodic scanning. Costs 2 * sizeof(status_time_t) bytes of RAM per
+ *    ID per class.
+ *
+ * @note Requires STATUS_TIME_NOW().
+ */
+#ifndef STATUS_ENABLE_TIME_IN_STATE
+#define STATUS_ENABLE_TIME_IN_STATE (0)
+#endif
+
+/**
+ * @def STATUS_ENABLE_HISTOGRAM
+ * @brief Record how long IDs stay active in log2-bucketed histograms.
+ *
+ * @details
+ *    IDs are bound to one of STATUS_HIST_SLOTS histograms with
+ *    status_hist_bind(); several IDs may share a slot to form a group. On
+ *    each clear edge the active duration is added to bucket floor(log2(d)).
+ *    Memory is fixed: 4 * STATUS_HIST_SLOTS * STATUS_HIST_BUCKETS bytes of
+ *    counters plus one byte per ID per class for the bindings.
+ *
+ * @note Requires STATUS_TIME_NOW().
+ */
+#ifndef STATUS_ENABLE_HISTOGRAM
+#define STATUS_ENABLE_HISTOGRAM (0)
+#endif
+
+/**
+ * @def STATUS_HIST_SLOTS
+ * @brief Number of duration histograms (1..254).
+ */
+#ifndef STATUS_HIST_SLOTS
+#define STATUS_HIST_SLOTS (8u)
+#endif
+
+/**
+ * @def STATUS_HIST_BUCKETS
+ * @brief Buckets per histogram (1..32). Bucket k counts durations in
+ *        [2^k, 2^(k+1)); bucket 0 also counts zero, the last bucket also
+ *        counts everything longer.
+ */
+#ifndef STATUS_HIST_BUCKETS
+#define STATUS_HIST_BUCKETS (16u)
+#endif
+
+/**
+ * @def STATUS_HIST_NONE
+ * @brief Slot value passed to status_hist_bind() to unbind an ID.
+ */
+#define STATUS_HIST_NONE (0xFFu)
+
+/**
+ * @def STATUS_ENABLE_PRIORITY
+ * @brief Track active IDs in a priority-indexed bitmap for an O(1)
+ *        status_highest_active() query.
+ *
+ * @details
+ *    Each ID may be given a unique rank with status_set_priority(). Set and
+ *    clear edges update a two-level bitmap (one summary word over
+ *    STATUS_PRIO_LEVELS / 32 level words), so the query is two
+ *    count-leading-zeros operations regardless of how many IDs are active.
+ *    Costs 2 bytes per ID plus 2 bytes per rank per class.
+ */
+#ifndef STATUS_ENABLE_PRIORITY
+#define STATUS_ENABLE_PRIORITY (0)
+#endif
+
+/**
+ * @def STATUS_PRIO_LEVELS
+ * @brief Number of distinct ranks per class; a multiple of 32 up to 1024.
+ */
+#ifndef STATUS_PRIO_LEVELS
+#define STATUS_PRIO_LEVELS (256u)
+#endif
+
+/**
+ * @def STATUS_PRIO_NONE
+ * @brief Rank passed to status_set_priority() to stop tracking an ID.
+ */
+#define STATUS_PRIO_NONE (0xFFFFu)
+
+/**
+ * @def STATUS_ENABLE_META
+ * @brief Read per-ID attributes from a const metadata table.
+ *
+ * @details
+ *    The application defines `status_meta_table` (see STATUS_META_ENTRY) in
+ *    ROM. The library then applies, without any search:
+ *    - debounce: a bit is raised only on the `debounce`-th consecutive set
+ *      request; any clear request restarts the count,
+ *    - latching: clear requests for IDs flagged STATUS_META_LATCH are
+ *      ignored until acknowledged with status_ack(),
+ *    - priority: with STATUS_ENABLE_PRIORITY, ranks are loaded from the
+ *      table by status_init().
+ *    Costs one byte of RAM per ID per class for the debounce counters.
+ */
+#ifndef STATUS_ENABLE_META
+#define STATUS_ENABLE_META (0)
+#endif
+
+/**
+ * @def STATUS_ENABLE_INTEGRITY
+ * @brief Maintain an incremental integrity word per class to detect memory
+ *        corruption of the banks.
+ *
+ * @details
+ *    Every bank write adds (new - old) * (2 * bank + 1) to a per-class sum
+ *    and subtracts it from a complemented copy, so the cost is constant per
+ *    write. Any change to a single bank outside the API changes the sum
+ *    (the weights are odd). status_verify() only checks the sum against its
+ *    complement in O(1); detecting a corrupted bank takes a full pass of
+ *    status_verify_step(), which recomputes the sum a few banks at a time
+ *    in the background. Costs 16 bytes of RAM per class.
+ */
+#ifndef STATUS_ENABLE_INTEGRITY
+#define STATUS_ENABLE_INTEGRITY (0)
+#endif
+
+/**
+ * @def STATUS_ENABLE_SHADOW
+ * @brief Keep a bitwise-complemented shadow copy of every bank and provide
+ *        a background scrubber that repairs single-copy corruption.
+ *
+ * @details
+ *    The shadow is written in the same critical section as the primary, so
+ *    primary == ~shadow holds between API calls. status_scrub_step() checks
+ *    a few banks per call and repairs mismatches. Doubles the bank storage
+ *    (2 bytes per bank per class).
+ */
+#ifndef STATUS_ENABLE_SHADOW
+#define STATUS_ENABLE_SHADOW (0)
+#endif
+
+/**
+ * @def STATUS_ENABLE_SOURCES
+ * @brief Track which producers assert each ID, so that an ID set by several
+ *        sources clears only once every source has released it.
+ *
+ * @details
+ *    status_source_set() / status_source_clear() keep a per-ID bitmap of up
+ *    to STATUS_SOURCES_MAX sources, updated in the same critical section as
+ *    the bank in O(1). Costs 1, 2 or 4 bytes per ID per class for up to 8,
+ *    16 or 32 sources.
+ */
+#ifndef STATUS_ENABLE_SOURCES
+#define STATUS_ENABLE_SOURCES (0)
+#endif
+
+/**
+ * @def STATUS_SOURCES_MAX
+ * @brief Number of distinct sources per ID (1..32).
+ */
+#ifndef STATUS_SOURCES_MAX
+#define STATUS_SOURCES_MAX (8u)
+#endif
+
+/**
+ * @def STATUS_ENABLE_BANK_ALLOC
+ * @brief Hand out contiguous bank ranges at runtime, for modules that
+ *        cannot share a compile-time ID header.
+ *
+ * @details
+ *    Banks STATUS_BANK_ALLOC_FIRST .. NUM_STATUS_BANKS - 1 are managed by
+ *    status_bank_alloc() / status_bank_free() through a free-bank bitmap;
+ *    lower banks stay reserved for compile-time IDs. Costs one bit per
+ *    bank.
+ */
+#ifndef STATUS_ENABLE_BANK_ALLOC
+#define STATUS_ENABLE_BANK_ALLOC (0)
+#endif
+
+/**
+ * @def STATUS_BANK_ALLOC_FIRST
+ * @brief First bank managed by the runtime allocator.
+ */
+#ifndef STATUS_BANK_ALLOC_FIRST
+#define STATUS_BANK_ALLOC_FIRST (0u)
+#endif
+
+/**
+ * @def STATUS_ENABLE_BANK_OWNERS
+ * @brief Record the owner of every allocated bank, check it on free and
+ *        provide owner-checked writes (status_set_owned() and friends).
+ *
+ * @note Requires STATUS_ENABLE_BANK_ALLOC. Costs one byte per bank.
+ */
+#ifndef STATUS_ENABLE_BANK_OWNERS
+#define STATUS_ENABLE_BANK_OWNERS (0)
+#endif
+
+/**
+ * @def STATUS_BANK_NONE
+ * @brief Returned by status_bank_alloc() when no range is free.
+ */
+#define STATUS_BANK_NONE (0xFFFFu)
+
+/**
+ * @def STATUS_OWNER_NONE
+ * @brief Owner of unallocated and compile-time banks; not a valid owner
+ *        for status_bank_alloc().
+ */
+#define STATUS_OWNER_NONE (0u)
+
+/**
+ * @def STATUS_ENABLE_DIRTY
+ * @brief Mark the banks whose value changed since they were last collected,
+ *        for incremental persistence (see status_persist.h).
+ *
+ * @details
+ *    Every bank write that changes the value sets one bit in a per-class
+ *    bitmap; status_dirty_next() hands the marked banks out with their
+ *    current value. Costs one bit per bank per class and one OR per write.
+ */
+#ifndef STATUS_ENABLE_DIRTY
+#define STATUS_ENABLE_DIRTY (0)
+#endif
+
+/**
+ * @def STATUS_ENABLE_EDGE_HOOK
+ * @brief Call an application hook for every bank write that changes a bank,
+ *        e.g. to wake C++ coroutines (see status_coro_c.hpp).
+ *
+ * @details
+ *    status_set_edge_hook() installs the hook. It gets the class, the bank
+ *    and its old and new value, and runs inside the critical section of the
+ *    write: it must be short and must not call the status API. status_init()
+ *    does not report the banks it clears. Costs one pointer test per write.
+ */
+#ifndef STATUS_ENABLE_EDGE_HOOK
+#define STATUS_ENABLE_EDGE_HOOK (0)
+#endif
+
+/* ---------------  Time Source --------------------------------------------- */
+
+/**
+ * @def STATUS_TIME_NOW
+ * @brief Return the current time as a status_time_t.
+ *
+ * @note Must be defined by the user when a time-aware feature is enabled.
+ *       It is evaluated inside the critical section, so it must be cheap and
+ *       safe to call from every context that sets or clears status bits.
+ */
+
 /* ---------------  Critical Sections --------------------------------------- */
 
 /**
@@ -78,6 +329,35 @@ extern "C" {
 #define STATUS_EXIT_CRITICAL()
 #endif
 
+/**
+ * @brief Enter a read-only critical section.
+ *
+ * @details
+ *    Used by the query and snapshot paths (status_is_*_set(), status_any(),
+ *    status_last_*(), status_snapshot() and the optional read accessors),
+ *    which never modify library state. Defaults to STATUS_ENTER_CRITICAL();
+ *    on a threaded host, map the pair to a reader lock (e.g.
+ *    pthread_rwlock_rdlock) and the exclusive pair to the writer lock so
+ *    readers proceed in parallel. Paired within one block scope like the
+ *    exclusive macros.
+ */
+#ifndef STATUS_ENTER_READ
+#define STATUS_ENTER_READ() STATUS_ENTER_CRITICAL()
+#endif
+
+/**
+ * @brief Exit a read-only critical section.
+ */
+#ifndef STATUS_EXIT_READ
+#define STATUS_EXIT_READ() STATUS_EXIT_CRITICAL()
+#endif
+
+/**
+ * @brief Constant query term initialiser, e.g.
+ *        { STATUS_QUERY_TERM(0u, 0x0003u), STATUS_QUERY_TERM(2u, 0x8000u) }.
+ */
+#define STATUS_QUERY_TERM(bank, mask) {(uint16_t)(bank), (uint16_t)(mask)}
+
 /* ================ STRUCTURES ============================================== */
 
 /**
@@ -89,6 +369,70 @@ enum status_class {
         STATUS_CLASS_INFO = 2,
 };
 
+/**
+ * @brief Constant attributes of one status ID.
+ *
+ * @note Entries not listed in the table are zero: unnamed, unranked, no
+ *       latch and no debounce.
+ */
+struct status_meta {
+        const char *name; /**< Identifier spelling, e.g. "STATUS_ID_..." */
+        uint16_t prio;    /**< Priority rank + 1; 0 = unranked */
+        uint8_t severity; /**< Application-defined severity */
+        uint8_t group;    /**< Application-defined group */
+        uint8_t flags;    /**< STATUS_META_* flags */
+        uint8_t debounce; /**< Consecutive sets required; 0 or 1 = none */
+};
+
+/**
+ * @brief One bank of a multi-ID query: the IDs of `bank` selected by `mask`.
+ *
+ * @details
+ *    Query term arrays are sorted by bank with each bank at most once. Build
+ *    them at init with status_query_compile(), or as constant initialisers
+ *    with STATUS_QUERY_TERM() (the generator emits
+ *    STATUS_GROUP_<group>_<class>_TERMS for every group).
+ */
+struct status_query_term {
+        uint16_t bank; /**< Bank index */
+        uint16_t mask; /**< IDs of the bank that belong to the query */
+};
+
+/**
+ * @brief How a status_cond combines its query terms.
+ */
+enum status_cond_op {
+        STATUS_COND_ANY = 0, /**< Any ID of the query is set */
+        STATUS_COND_ALL,     /**< Every ID of the query is set */
+        STATUS_COND_NONE,    /**< No ID of the query is set */
+};
+
+/**
+ * @brief Predicate for status_set_if() / status_clear_unless().
+ *
+ * @details
+ *    The query may name a different class than the ID being updated, e.g.
+ *    "set warning W only if no fault of group G is active".
+ */
+struct status_cond {
+        enum status_class cls;                  /**< Class the query reads */
+        const struct status_query_term *terms; /**< Sorted query terms */
+        size_t n;                               /**< Number of terms */
+        enum status_cond_op op;                 /**< How terms combine */
+};
+
+/**
+ * @brief Aggregated occurrences of one status_err_t since status_init().
+ *
+ * @note `first_id` and `last_id` are meaningful only when `count` > 0; they
+ *       hold STATUS_UNSET_ID for errors not tied to an ID.
+ */
+struct status_err_stats {
+        uint32_t count;    /**< Occurrences, saturating at UINT32_MAX */
+        uint16_t first_id; /**< ID passed with the first occurrence */
+        uint16_t last_id;  /**< ID passed with the latest occurrence */
+};
+
 /* ================ TYPEDEFS ================================================ */
 
 /**
@@ -98,14 +442,44 @@ typedef enum {
         STATUS_ERR_INVALID_ID = 0, /**< Unrecognised status_class value */
         STATUS_ERR_INVALID_BANK,   /**< Bank index >= NUM_STATUS_BANKS */
         STATUS_ERR_INVALID_LEN,    /**< Zero-length argument to snapshot */
-        STATUS_ERR_NULL_PTR        /**< NULL pointer argument */
+        STATUS_ERR_NULL_PTR,       /**< NULL pointer argument */
+        STATUS_ERR_INVALID_ARG,    /**< Argument outside its documented range */
+        STATUS_ERR_INTEGRITY,      /**< Register contents failed verification */
+        STATUS_ERR_NOT_OWNER       /**< Bank belongs to another owner */
 } status_err_t;
 
+/**
+ * @def STATUS_ERR_NUM
+ * @brief Number of status_err_t values; length of the status_err_stats()
+ *        table.
+ */
+#define STATUS_ERR_NUM ((size_t)STATUS_ERR_NOT_OWNER + 1u)
+
 /**
  * @brief Callback function type for error handling.
  */
 typedef void (*status_err_cb_t)(status_err_t err, uint16_t id);
 
+/**
+ * @brief Bank edge hook; see STATUS_ENABLE_EDGE_HOOK.
+ */
+typedef void (*status_edge_cb_t)(enum status_class cls, uint16_t bank,
+                                 uint16_t old_val, uint16_t new_val,
+                                 void *ctx);
+
+/**
+ * @brief Monotonic tick count used by the time-aware features.
+ *
+ * @note The unit is application-defined (e.g. milliseconds or scheduler
+ *       ticks). Values wrap modulo 2^32; intervals must stay below 2^31 ticks.
+ */
+typedef uint32_t status_time_t;
+
+/**
+ * @brief Multi-bit field packed inside one bank; see STATUS_FIELD().
+ */
+typedef uint32_t status_field_t;
+
 /* ================ MACROS ================================================== */
 
 /**
@@ -136,8 +510,81 @@ typedef void (*status_err_cb_t)(status_err_t err, uint16_t id);
 #define STATUS_ENCODE(bank, bit)                                               \
         ((uint16_t)(((uint32_t)(bank) << 4u) | ((uint32_t)(bit) & 0x0Fu)))
 
+/**
+ * @def STATUS_FIELD
+ * @brief Encodes a `width`-bit field starting at bit `shift` of `bank`.
+ *
+ * @param bank      Bank index (< NUM_STATUS_BANKS).
+ * @param shift     Lowest bit of the field (0–15).
+ * @param width     Field width in bits (1–16); shift + width must be <= 16.
+ *
+ * @details
+ *    A field holds a small value (a 4-level severity, a saturating counter)
+ *    in the bits of one bank, so one status_field_set() replaces several
+ *    status_set_*() / status_clear_*() calls. For status_field_count_at_least()
+ *    place fields of one width on multiples of that width.
+ */
+#define STATUS_FIELD(bank, shift, width)                                       \
+        ((status_field_t)(((uint32_t)(bank) << 8u)                             \
+                          | (((uint32_t)(shift) & 0x0Fu) << 4u)                \
+                          | (((uint32_t)(width) - 1u) & 0x0Fu)))
+
+#if STATUS_ENABLE_META
+/**
+ * @def STATUS_META_LEN
+ * @brief Entries per class in status_meta_table; indexed by status ID.
+ */
+#define STATUS_META_LEN (NUM_STATUS_BANKS * NUM_STATUS_BITS)
+
+/**
+ * @def STATUS_META_LATCH
+ * @brief Metadata flag: the bit stays set until status_ack().
+ */
+#define STATUS_META_LATCH (0x01u)
+
+/**
+ * @def STATUS_META_ENTRY
+ * @brief X-macro adapter producing one designated initializer of
+ *        status_meta_table.
+ *
+ * @param id        Status ID macro (its spelling becomes the name).
+ * @param rank      Priority rank, or STATUS_PRIO_NONE.
+ * @param sev       Severity.
+ * @param grp       Group.
+ * @param flg       STATUS_META_* flags.
+ * @param deb       Debounce count.
+ *
+ * @details
+ *    List IDs once next to their STATUS_ENCODE definitions, then expand the
+ *    list inside the table in exactly one translation unit:
+ *
+ *    @code
+ *    #define APP_FAULT_META(X)                                            \
+ *            X(STATUS_ID_FAULT_OVERCURRENT, 200u, 3u, 0u, STATUS_META_LATCH, 0u)
+ *
+ *    const struct status_meta status_meta_table[3][STATUS_META_LEN] = {
+ *            [STATUS_CLASS_FAULT] = {APP_FAULT_META(STATUS_META_ENTRY)},
+ *    };
+ *    @endcode
+ */
+#define STATUS_META_ENTRY(id, rank, sev, grp, flg, deb)                        \
+        [(id)] = {.name = #id,                                                 \
+                  .prio = (uint16_t)((uint32_t)(rank) + 1u),                   \
+                  .severity = (uint8_t)(sev),                                  \
+                  .group = (uint8_t)(grp),                                     \
+                  .flags = (uint8_t)(flg),                                     \
+                  .debounce = (uint8_t)(deb)},
+#endif
+
 /* ================ GLOBAL VARIABLES ======================================== */
 
+#if STATUS_ENABLE_META
+/**
+ * @brief Application-defined metadata, indexed [class][status ID].
+ */
+extern const struct status_meta status_meta_table[3][STATUS_META_LEN];
+#endif
+
 /* ================ GLOBAL PROTOTYPES ======================================= */
 
 /**
@@ -166,12 +613,90 @@ status_bit(uint16_t id)
         return (uint16_t)(id & 0x0Fu);
 }
 
+/**
+ * @brief Bank of a field encoded with STATUS_FIELD().
+ */
+static inline uint16_t
+status_field_bank(status_field_t f)
+{
+        return (uint16_t)(f >> 8u);
+}
+
+/**
+ * @brief Lowest bit of a field encoded with STATUS_FIELD().
+ */
+static inline uint16_t
+status_field_shift(status_field_t f)
+{
+        return (uint16_t)((f >> 4u) & 0x0Fu);
+}
+
+/**
+ * @brief Width in bits (1–16) of a field encoded with STATUS_FIELD().
+ */
+static inline uint16_t
+status_field_width(status_field_t f)
+{
+        return (uint16_t)((f & 0x0Fu) + 1u);
+}
+
+#if STATUS_ENABLE_META
+/**
+ * @brief Look up the metadata of a status ID.
+ *
+ * @return          The table entry, or NULL if `cls` or `id` is out of range.
+ */
+static inline const struct status_meta *
+status_meta_get(enum status_class cls, uint16_t id)
+{
+        return (((unsigned int)cls < 3u) && (id < STATUS_META_LEN))
+                   ? &status_meta_table[cls][id]
+                   : NULL;
+}
+
+/**
+ * @brief Name of a status ID, or NULL if out of range or unnamed.
+ */
+static inline const char *
+status_meta_name(enum status_class cls, uint16_t id)
+{
+        const struct status_meta *m = status_meta_get(cls, id);
+
+        return (m != NULL) ? m->name : NULL;
+}
+
+/**
+ * @brief Severity of a status ID; 0 if out of range or unlisted.
+ */
+static inline uint8_t
+status_meta_severity(enum status_class cls, uint16_t id)
+{
+        const struct status_meta *m = status_meta_get(cls, id);
+
+        return (m != NULL) ? m->severity : 0u;
+}
+
+/**
+ * @brief Group of a status ID; 0 if out of range or unlisted.
+ */
+static inline uint8_t
+status_meta_group(enum status_class cls, uint16_t id)
+{
+        const struct status_meta *m = status_meta_get(cls, id);
+
+        return (m != NULL) ? m->group : 0u;
+}
+#endif
+
 /**
  * @brief Initialise the status module.
  *
  * @note Clears all register banks and resets the last-set ID trackers for
  *       every class. The registered error callback is intentionally preserved
  *       so that errors occurring during re-initialisation are still reported.
+ *       With STATUS_ENABLE_META and STATUS_ENABLE_PRIORITY, ranks are
+ *       reloaded from status_meta_table; a duplicate or out-of-range rank
+ *       reports STATUS_ERR_INVALID_ARG with the first offending ID.
  */
 void status_init(void);
 
@@ -184,6 +709,34 @@ void status_init(void);
  */
 void status_set_err_callback(status_err_cb_t cb);
 
+/**
+ * @brief Coalesce repeated errors before they reach the callback.
+ *
+ * @details
+ *    Every error is counted (see status_err_stats()), but the callback only
+ *    runs for the 1st, (N+1)th, (2N+1)th, ... occurrence of each
+ *    status_err_t. An error storm then costs a counter update per call
+ *    instead of a callback round trip. The count restarts at status_init().
+ *
+ * @param every_n   Occurrences per callback; 0 or 1 (the default) reports
+ *                  every error.
+ *
+ * @note With lock-free C11 atomics available the error path takes no
+ *       critical section; otherwise the counters are updated inside one.
+ */
+void status_set_err_rate_limit(uint32_t every_n);
+
+/**
+ * @brief Copy the per-error counters, indexed by status_err_t.
+ *
+ * @param dst       Destination table.
+ * @param len       Number of entries in `dst`; at most STATUS_ERR_NUM are
+ *                  written.
+ *
+ * @note Errors are reported as for status_snapshot().
+ */
+void status_err_stats(struct status_err_stats *dst, size_t len);
+
 /**
  * @brief Set the given warning status bit.
  */
@@ -223,6 +776,13 @@ void status_clear_fault(uint16_t id);
  */
 void status_clear_info(uint16_t id);
 
+#if STATUS_ENABLE_META
+/**
+ * @brief Acknowledge a status ID: clear it even if it is latched.
+ */
+void status_ack(enum status_class cls, uint16_t id);
+#endif
+
 /**
  * @brief Check whether a given warning status bit is set.
  */
@@ -291,6 +851,448 @@ uint16_t status_last_info(void);
  */
 void status_snapshot(enum status_class cls, uint16_t *dst, size_t len);
 
+/**
+ * @brief Compile a list of IDs into sorted, merged query terms.
+ *
+ * @param dst       Term array with space for `cap` entries.
+ * @param cap       Capacity of `dst`; one term per distinct bank is needed.
+ * @param ids       Status IDs, in any order; duplicates are allowed.
+ * @param n         Number of IDs.
+ *
+ * @return          Number of terms written, or 0 on error.
+ *
+ * @note Intended for init time (O(n * terms)). Errors are reported through
+ *       the callback and nothing useful is written:
+ *       - NULL dst or ids      → STATUS_ERR_NULL_PTR
+ *       - n == 0 or too small `cap` → STATUS_ERR_INVALID_LEN
+ *       - ID bank out of range → STATUS_ERR_INVALID_BANK (with the ID)
+ */
+size_t status_query_compile(struct status_query_term *dst, size_t cap,
+                            const uint16_t *ids, size_t n);
+
+/**
+ * @brief True if any ID of the query is set.
+ *
+ * @details
+ *    Reads each bank of the query once under a single read section and
+ *    stops at the first hit.
+ *
+ * @note Invalid cls reports STATUS_ERR_INVALID_ID, NULL terms
+ *       STATUS_ERR_NULL_PTR and a term outside the register
+ *       STATUS_ERR_INVALID_BANK; the result is then false.
+ */
+bool status_query_any(enum status_class cls,
+                      const struct status_query_term *terms, size_t n);
+
+/**
+ * @brief True if every ID of the query is set.
+ *
+ * @note An empty query is vacuously true. Errors as for status_query_any();
+ *       the result is then false.
+ */
+bool status_query_all(enum status_class cls,
+                      const struct status_query_term *terms, size_t n);
+
+/**
+ * @brief Report which IDs of the query are set.
+ *
+ * @param dst       Receives, per term, bank & mask (the active members).
+ *                  Must have space for `n` entries.
+ *
+ * @return          Number of active IDs across all terms; 0 on error.
+ *
+ * @note All banks are read under a single read section, so the result is a
+ *       consistent picture of the queried IDs. Errors as for
+ *       status_query_any(), plus NULL dst → STATUS_ERR_NULL_PTR.
+ */
+size_t status_query_collect(enum status_class cls,
+                            const struct status_query_term *terms, size_t n,
+                            uint16_t *dst);
+
+/**
+ * @brief Set an ID only if a condition holds, atomically.
+ *
+ * @param cls       Class of the ID to set.
+ * @param id        The status ID to set.
+ * @param cond      Predicate over any class; evaluated under the same
+ *                  exclusive critical section as the update.
+ *
+ * @return          True if the condition held and the set was applied
+ *                  (even if the bit was already set).
+ *
+ * @details
+ *    One STATUS_ENTER_CRITICAL()/STATUS_EXIT_CRITICAL() pair covers both
+ *    the predicate and the write, so no other writer can change the
+ *    condition in between. The set goes through the same hooks as
+ *    status_set_*() (meta latching, time-in-state, priority, integrity).
+ *
+ * @note Invalid id/cls reports STATUS_ERR_INVALID_BANK or
+ *       STATUS_ERR_INVALID_ID, NULL cond (or NULL terms with n > 0)
+ *       STATUS_ERR_NULL_PTR, a bad cond class or op STATUS_ERR_INVALID_ARG,
+ *       and a term outside the register STATUS_ERR_INVALID_BANK. Nothing is
+ *       written in those cases and the result is false.
+ */
+bool status_set_if(enum status_class cls, uint16_t id,
+                   const struct status_cond *cond);
+
+/**
+ * @brief Clear an ID unless a condition holds, atomically.
+ *
+ * @return          True if the condition did not hold and the clear was
+ *                  applied (subject to latching, as status_clear_*()).
+ *
+ * @note Parameters, locking and errors as for status_set_if().
+ */
+bool status_clear_unless(enum status_class cls, uint16_t id,
+                         const struct status_cond *cond);
+
+/**
+ * @brief Write a multi-bit field with one masked read-modify-write.
+ *
+ * @param cls       The class of status.
+ * @param f         Field encoded with STATUS_FIELD().
+ * @param value     New value, 0 .. 2^width - 1.
+ *
+ * @details
+ *    The whole field is replaced in one critical section, so readers never
+ *    see a mix of old and new bits. Bits that change go through the
+ *    optional edge features like any set/clear; the debounce and latch
+ *    filters of STATUS_ENABLE_META and the last-set IDs do not apply to
+ *    fields.
+ *
+ * @note A bank outside the register reports STATUS_ERR_INVALID_BANK, an
+ *       invalid class STATUS_ERR_INVALID_ID, and a field crossing bit 15 or
+ *       a `value` wider than the field STATUS_ERR_INVALID_ARG, each with
+ *       the ID of the field's lowest bit. Nothing is written.
+ */
+void status_field_set(enum status_class cls, status_field_t f, uint16_t value);
+
+/**
+ * @brief Read a multi-bit field.
+ *
+ * @return          The field value, or 0 on error (reported as for
+ *                  status_field_set()).
+ */
+uint16_t status_field_get(enum status_class cls, status_field_t f);
+
+/**
+ * @brief Count the fields of a bank range whose value is >= `level`.
+ *
+ * @param cls       The class of status.
+ * @param bank      First bank of the range.
+ * @param n_banks   Number of banks in the range.
+ * @param width     Width of every field in the range: 1, 2, 4, 8 or 16.
+ *                  Fields are assumed to sit on multiples of `width`.
+ * @param level     Threshold; 0 counts every field.
+ *
+ * @return          Number of fields at or above `level`; 0 on error.
+ *
+ * @details
+ *    All fields of a bank are compared at once with word-wise carry
+ *    arithmetic, so the cost is a few operations per bank regardless of
+ *    the field width, under a single read section.
+ *
+ * @note A range outside the register reports STATUS_ERR_INVALID_BANK, an
+ *       invalid class STATUS_ERR_INVALID_ID and an unsupported width
+ *       STATUS_ERR_INVALID_ARG (with STATUS_UNSET_ID).
+ */
+size_t status_field_count_at_least(enum status_class cls, uint16_t bank,
+                                   uint16_t n_banks, uint16_t width,
+                                   uint16_t level);
+
+/**
+ * @brief True if any field of a bank range is >= `level`.
+ *
+ * @details
+ *    As status_field_count_at_least(), stopping at the first bank with a
+ *    match.
+ */
+bool status_field_any_at_least(enum status_class cls, uint16_t bank,
+                               uint16_t n_banks, uint16_t width,
+                               uint16_t level);
+
+#if STATUS_ENABLE_TIME_IN_STATE
+/**
+ * @brief Copy the cumulative active time of every ID in a class.
+ *
+ * @param cls       The class of status.
+ * @param dst       Destination array indexed by status ID (bank * 16 + bit).
+ * @param len       Number of entries to copy; capped at
+ *                  NUM_STATUS_BANKS * NUM_STATUS_BITS.
+ *
+ * @details
+ *    Time accrued by currently active IDs is included, so the result is
+ *    exact as of the call. Accumulators
+ *    saturate at UINT32_MAX and are reset by status_init().
+ *
+ * @note Errors are reported as for status_snapshot().
+ */
+void status_time_in_state(enum status_class cls, status_time_t *dst,
+                          size_t len);
+#endif
+
+#if STATUS_ENABLE_HISTOGRAM
+/**
+ * @brief Bind an ID to a duration histogram.
+ *
+ * @param cls       The class of status.
+ * @param id        Status ID whose active durations are recorded.
+ * @param slot      Histogram index (< STATUS_HIST_SLOTS), or
+ *                  STATUS_HIST_NONE to stop recording the ID.
+ *
+ * @note Bindings survive status_init(); counters do not. An out-of-range
+ *       slot reports STATUS_ERR_INVALID_ARG.
+ */
+void status_hist_bind(enum status_class cls, uint16_t id, uint8_t slot);
+
+/**
+ * @brief Export every histogram in one call.
+ *
+ * @param dst       Destination laid out as [slot][bucket].
+ * @param len       Number of counters to copy; capped at
+ *                  STATUS_HIST_SLOTS * STATUS_HIST_BUCKETS.
+ *
+ * @note Counters saturate at UINT32_MAX. NULL dst and len == 0 are
+ *       reported as for status_snapshot().
+ */
+void status_hist_export(uint32_t *dst, size_t len);
+#endif
+
+#if STATUS_ENABLE_PRIORITY
+/**
+ * @brief Assign the rank used by status_highest_active().
+ *
+ * @param cls       The class of status.
+ * @param id        Status ID to rank.
+ * @param rank      0 .. STATUS_PRIO_LEVELS - 1, higher is more severe, or
+ *                  STATUS_PRIO_NONE to stop tracking the ID.
+ *
+ * @note Ranks are unique within a class: assigning a rank held by another ID
+ *       reports STATUS_ERR_INVALID_ARG and leaves both unchanged. Ranks
+ *       survive status_init().
+ */
+void status_set_priority(enum status_class cls, uint16_t id, uint16_t rank);
+
+/**
+ * @brief Return the active ID with the highest rank in a class.
+ *
+ * @return          The status ID, or STATUS_UNSET_ID if no ranked ID is
+ *                  active. Unranked IDs are never returned.
+ */
+uint16_t status_highest_active(enum status_class cls);
+#endif
+
+#if STATUS_ENABLE_INTEGRITY
+/**
+ * @brief O(1) check that the integrity word of a class is intact.
+ *
+ * @details
+ *    Only compares the maintained sum with its complemented copy, which
+ *    catches corruption of the check words themselves. The banks are not
+ *    read, so a corrupted bank passes this check; bank coverage comes from
+ *    status_verify_step(), which re-sums the banks in the background.
+ *
+ * @return          true if the sum and its complement agree. On mismatch
+ *                  STATUS_ERR_INTEGRITY is reported and false returned.
+ *
+ * @note An invalid class reports STATUS_ERR_INVALID_ID and returns false.
+ */
+bool status_verify(enum status_class cls);
+
+/**
+ * @brief Advance the background full check of a class by `n` banks.
+ *
+ * @details
+ *    Re-sums up to `n` banks under one critical section, resuming where
+ *    the previous call stopped. Writes made while a pass is in progress are
+ *    folded in, so the pass stays exact. When the pass reaches the last bank
+ *    the recomputed sum is compared with the integrity word and the next
+ *    call starts a new pass. Call it from an idle loop with a small `n` to
+ *    bound the time spent in the critical section.
+ *
+ * @return          false if a pass completed with a mismatch (also reported
+ *                  as STATUS_ERR_INTEGRITY), true otherwise.
+ */
+bool status_verify_step(enum status_class cls, size_t n);
+#endif
+
+#if STATUS_ENABLE_SHADOW
+/**
+ * @brief Verify and repair the next `n` banks against their shadow copies.
+ *
+ * @details
+ *    A rotating cursor walks every bank of the fault, warning and info
+ *    classes in turn, so repeated calls cover the whole register. Each bank
+ *    is checked under its own critical section. A bank whose primary is not
+ *    the complement of its shadow is repaired to primary | ~shadow: a bit
+ *    present in either copy is kept, so a corrupted copy can raise a
+ *    spurious status but never lose an active one. The repair is applied as
+ *    a normal write from the primary's value, so the optional edge features
+ *    see it like any set.
+ *
+ *    A set, clear or field write to a bank whose copies disagree applies the
+ *    same repair first and then writes both copies, so a later write never
+ *    copies a corrupted primary into the shadow. Such repairs are counted
+ *    and reported by the next call.
+ *
+ * @return          Number of banks repaired, including those repaired by
+ *                  writes since the previous call. Each repair found by the
+ *                  scan is reported as STATUS_ERR_INTEGRITY with the ID of
+ *                  the lowest differing bit; repairs made by writes are
+ *                  reported once per call, with the ID of the first one.
+ */
+size_t status_scrub_step(size_t n);
+#endif
+
+#if STATUS_ENABLE_SOURCES
+/**
+ * @brief Assert an ID on behalf of one source.
+ *
+ * @param cls       The class of status.
+ * @param id        The status ID.
+ * @param src       Source index, 0 .. STATUS_SOURCES_MAX - 1.
+ *
+ * @details
+ *    Sets the ID as status_set_*() does (debounce and the edge features
+ *    apply) and records the source once the set is accepted: a request
+ *    held back by debounce asserts no source. Asserting twice from the
+ *    same source is the same as asserting once.
+ *
+ * @note Invalid id/cls is reported as for status_set_*(); `src` out of
+ *       range reports STATUS_ERR_INVALID_ARG. Nothing changes in either
+ *       case.
+ */
+void status_source_set(enum status_class cls, uint16_t id, uint8_t src);
+
+/**
+ * @brief Release an ID on behalf of one source.
+ *
+ * @details
+ *    The ID is cleared, as with status_clear_*(), only when the last source
+ *    asserting it releases it. Releasing a source that does not assert the
+ *    ID has no effect.
+ *
+ * @note A plain status_clear_*() or status_clear_all() clears the ID
+ *       regardless of its sources and drops all of them. Errors as for
+ *       status_source_set().
+ */
+void status_source_clear(enum status_class cls, uint16_t id, uint8_t src);
+
+/**
+ * @brief Bitmap of the sources currently asserting an ID (bit n = source n).
+ *
+ * @return          0 if no source asserts it, or the ID is invalid.
+ */
+uint32_t status_source_mask(enum status_class cls, uint16_t id);
+#endif
+
+#if STATUS_ENABLE_BANK_ALLOC
+/**
+ * @brief Allocate `n_banks` contiguous banks.
+ *
+ * @param n_banks   Number of banks (> 0).
+ * @param owner     Caller's owner token (e.g. a module index); must not be
+ *                  STATUS_OWNER_NONE when STATUS_ENABLE_BANK_OWNERS is set.
+ *
+ * @return          First bank of the range, or STATUS_BANK_NONE if no free
+ *                  run is long enough. IDs of the range are
+ *                  STATUS_ENCODE(first + i, bit).
+ *
+ * @details
+ *    First fit over the free-bank bitmap: count-trailing-zeros jumps from
+ *    one free run to the next, so the cost is one step per free run
+ *    visited (one word operation for up to 32 banks), not per bank.
+ *    Banks are cleared when released, so a new owner starts from a clean
+ *    range.
+ *
+ * @note n_banks == 0 reports STATUS_ERR_INVALID_LEN, an invalid owner
+ *       STATUS_ERR_INVALID_ARG; both return STATUS_BANK_NONE.
+ */
+uint16_t status_bank_alloc(uint16_t n_banks, uint8_t owner);
+
+/**
+ * @brief Release a range returned by status_bank_alloc(), e.g. when its
+ *        module is unloaded.
+ *
+ * @details
+ *    Clears the banks in all three classes (as status_clear_all() would,
+ *    edge features included) and returns them to the free bitmap.
+ *
+ * @note Nothing is released, and the error is reported with the ID of the
+ *       first offending bank, if the range leaves the managed banks
+ *       (STATUS_ERR_INVALID_BANK), includes a free bank
+ *       (STATUS_ERR_INVALID_ARG) or, with STATUS_ENABLE_BANK_OWNERS, a bank
+ *       of another owner (STATUS_ERR_NOT_OWNER).
+ */
+void status_bank_free(uint16_t first, uint16_t n_banks, uint8_t owner);
+
+#if STATUS_ENABLE_BANK_OWNERS
+/**
+ * @brief Owner of a bank; STATUS_OWNER_NONE if free, compile-time or out
+ *        of range.
+ */
+uint8_t status_bank_owner(uint16_t bank);
+
+/**
+ * @brief Set an ID, checking that its bank belongs to `owner`.
+ *
+ * @details
+ *    The owner check is one byte compare inside the set's critical section.
+ *    A write to a bank of another owner (a misrouted ID) is dropped and
+ *    reported as STATUS_ERR_NOT_OWNER with the ID. Other errors as for
+ *    status_set_*().
+ */
+void status_set_owned(enum status_class cls, uint16_t id, uint8_t owner);
+
+/**
+ * @brief Clear an ID, checking that its bank belongs to `owner`.
+ *
+ * @note Errors as for status_set_owned().
+ */
+void status_clear_owned(enum status_class cls, uint16_t id, uint8_t owner);
+#endif
+#endif
+
+#if STATUS_ENABLE_DIRTY
+/**
+ * @brief Collect one changed bank and unmark it.
+ *
+ * @param cls       Receives the class of the bank.
+ * @param bank      Receives the bank index.
+ * @param value     Receives the current value of the bank.
+ *
+ * @return          False, outputs untouched, if no bank is marked.
+ *
+ * @details
+ *    Lowest class, then lowest bank first. The mark is cleared and the
+ *    value read in one critical section, so a write after the call marks
+ *    the bank again and is never lost. O(NUM_STATUS_BANKS / 32).
+ *
+ * @note A NULL output reports STATUS_ERR_NULL_PTR.
+ */
+bool status_dirty_next(enum status_class *cls, uint16_t *bank,
+                       uint16_t *value);
+
+/**
+ * @brief Unmark every bank, e.g. once a persisted state has been restored.
+ */
+void status_dirty_clear(void);
+#endif
+
+#if STATUS_ENABLE_EDGE_HOOK
+/**
+ * @brief Install the bank edge hook.
+ *
+ * @param cb        Called with `ctx` after every bank write that changes the
+ *                  bank, inside its critical section. NULL removes the hook.
+ * @param ctx       Passed to every call.
+ *
+ * @note With STATUS_ENABLE_SHADOW, `old_val` is the value last written even
+ *       if the primary was corrupted since (see status_scrub_step()).
+ */
+void status_set_edge_hook(status_edge_cb_t cb, void *ctx);
+#endif
+
 /* End of C bindings for C++ compilers */
 #ifdef __cplusplus
 }
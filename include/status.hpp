@@ -0,0 +1,255 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status.hpp
+ *
+ * @brief Header-only C++17 status register with class-typed, compile-time
+ *        checked IDs.
+ *
+ * @details
+ *    Independent of the C library: each status_register owns its storage
+ *    (std::atomic words) and needs no critical-section macros. An ID carries
+ *    its class, bank and bit in its type, so a fault ID can only ever touch
+ *    the fault banks, and an out-of-range bank or bit fails to compile. Every
+ *    operation on a typed ID inlines to one atomic load or RMW on a constant
+ *    address with a constant mask.
+ *
+ *    With the default 16-bit word, id::value matches STATUS_ENCODE(bank, bit)
+ *    so IDs can be handed to the C API or the host tools.
+ */
+
+#ifndef STATUS_HPP
+#define STATUS_HPP
+
+/* ================ INCLUDES ================================================ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace status {
+
+/* ================ TYPEDEFS ================================================ */
+
+/**
+ * @brief Status class; values match enum status_class.
+ */
+enum class id_class : unsigned char {
+        fault = 0,
+        warning = 1,
+        info = 2,
+};
+
+inline constexpr std::size_t num_classes = 3u;
+
+/* ================ STRUCTURES ============================================== */
+
+/**
+ * @brief Compile-time status ID.
+ *
+ * @tparam Cls  Class the ID belongs to.
+ * @tparam Bank Bank index; checked against the register's bank count.
+ * @tparam Bit  Bit within the bank; checked against the register's word.
+ */
+template <id_class Cls, std::size_t Bank, unsigned Bit>
+struct status_id {
+        static_assert(Bit < std::numeric_limits<std::uint64_t>::digits,
+                      "bit index exceeds the widest supported word");
+
+        static constexpr id_class cls = Cls;
+        static constexpr std::size_t bank = Bank;
+        static constexpr unsigned bit = Bit;
+
+        /** Dense 16-bit encoding (bank << 4 | bit), as STATUS_ENCODE(). */
+        static constexpr std::uint16_t value =
+            static_cast<std::uint16_t>((Bank << 4u) | (Bit & 0x0Fu));
+};
+
+template <std::size_t Bank, unsigned Bit>
+using fault_id = status_id<id_class::fault, Bank, Bit>;
+
+template <std::size_t Bank, unsigned Bit>
+using warning_id = status_id<id_class::warning, Bank, Bit>;
+
+template <std::size_t Bank, unsigned Bit>
+using info_id = status_id<id_class::info, Bank, Bit>;
+
+/**
+ * @brief Default register observer: ignores every change and compiles away.
+ *
+ * @details
+ *    An observer is told about each bank write after it happened:
+ *    on_change(cls, bank, old_val, new_val), called on the writing thread
+ *    with no lock held. See status_coro.hpp for a coroutine observer.
+ */
+struct no_observer {
+        template <class Word>
+        void
+        on_change(id_class, std::size_t, Word, Word) noexcept
+        {
+        }
+};
+
+/**
+ * @brief Banked status register for all three classes.
+ *
+ * @tparam Banks    Banks per class.
+ * @tparam Word     Unsigned bank word; must be lock-free as std::atomic.
+ * @tparam Observer Receives every bank change; no_observer by default.
+ *
+ * @note Writes use acq_rel and reads acquire ordering, so a status seen as
+ *       set also publishes the writes made before it was set. Multi-bank
+ *       operations (any, clear_all, snapshot) are per-word atomic, not
+ *       atomic as a whole.
+ */
+template <std::size_t Banks, class Word = std::uint16_t,
+          class Observer = no_observer>
+class status_register : private Observer {
+        static_assert(Banks > 0u, "a register needs at least one bank");
+        static_assert(std::is_unsigned_v<Word>, "Word must be unsigned");
+        static_assert(std::atomic<Word>::is_always_lock_free,
+                      "Word must be lock-free");
+
+        static constexpr unsigned word_bits =
+            static_cast<unsigned>(std::numeric_limits<Word>::digits);
+
+        template <class Id>
+        static constexpr Word
+        mask_of() noexcept
+        {
+                static_assert(Id::bank < Banks, "status ID bank out of range");
+                static_assert(Id::bit < word_bits, "status ID bit out of range");
+                return static_cast<Word>(Word{1} << Id::bit);
+        }
+
+        template <class Id>
+        std::atomic<Word> &
+        word_of() noexcept
+        {
+                return banks_[static_cast<std::size_t>(Id::cls)][Id::bank];
+        }
+
+        template <class Id>
+        const std::atomic<Word> &
+        word_of() const noexcept
+        {
+                return banks_[static_cast<std::size_t>(Id::cls)][Id::bank];
+        }
+
+    public:
+        using word_type = Word;
+        using observer_type = Observer;
+        static constexpr std::size_t num_banks = Banks;
+        static constexpr unsigned bits_per_bank = word_bits;
+
+        constexpr status_register() noexcept = default;
+        status_register(const status_register &) = delete;
+        status_register &operator=(const status_register &) = delete;
+
+        /** Set the status identified by `Id`. */
+        template <class Id>
+        void
+        set(Id = {}) noexcept
+        {
+                const Word old = word_of<Id>().fetch_or(
+                    mask_of<Id>(), std::memory_order_acq_rel);
+
+                Observer::on_change(Id::cls, Id::bank, old,
+                                    static_cast<Word>(old | mask_of<Id>()));
+        }
+
+        /** Clear the status identified by `Id`. */
+        template <class Id>
+        void
+        clear(Id = {}) noexcept
+        {
+                const Word old = word_of<Id>().fetch_and(
+                    static_cast<Word>(~mask_of<Id>()),
+                    std::memory_order_acq_rel);
+
+                Observer::on_change(Id::cls, Id::bank, old,
+                                    static_cast<Word>(old & ~mask_of<Id>()));
+        }
+
+        /** True if the status identified by `Id` is set. */
+        template <class Id>
+        bool
+        is_set(Id = {}) const noexcept
+        {
+                return (word_of<Id>().load(std::memory_order_acquire)
+                        & mask_of<Id>())
+                       != Word{0};
+        }
+
+        /** True if any status of `cls` is set. */
+        bool
+        any(id_class cls) const noexcept
+        {
+                for (const auto &w : banks_[static_cast<std::size_t>(cls)]) {
+                        if (w.load(std::memory_order_acquire) != Word{0}) {
+                                return true;
+                        }
+                }
+                return false;
+        }
+
+        /** Clear every status of `cls`. */
+        void
+        clear_all(id_class cls) noexcept
+        {
+                auto &b = banks_[static_cast<std::size_t>(cls)];
+
+                for (std::size_t i = 0u; i < Banks; ++i) {
+                        if constexpr (std::is_same_v<Observer, no_observer>) {
+                                b[i].store(Word{0}, std::memory_order_release);
+                        } else {
+                                const Word old = b[i].exchange(
+                                    Word{0}, std::memory_order_acq_rel);
+
+                                Observer::on_change(cls, i, old, Word{0});
+                        }
+                }
+        }
+
+        /** Current word of (cls, bank); `bank` must be below num_banks. */
+        Word
+        load(id_class cls, std::size_t bank) const noexcept
+        {
+                return banks_[static_cast<std::size_t>(cls)][bank].load(
+                    std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Copy up to `len` banks of `cls` into `dst`.
+         *
+         * @return Banks copied.
+         */
+        std::size_t
+        snapshot(id_class cls, Word *dst, std::size_t len) const noexcept
+        {
+                const std::size_t n = (len < Banks) ? len : Banks;
+                const auto &b = banks_[static_cast<std::size_t>(cls)];
+
+                for (std::size_t i = 0u; i < n; ++i) {
+                        dst[i] = b[i].load(std::memory_order_acquire);
+                }
+                return n;
+        }
+
+        /** The observer instance, e.g. to register waiters on it. */
+        Observer &
+        observer() noexcept
+        {
+                return *this;
+        }
+
+    private:
+        std::array<std::array<std::atomic<Word>, Banks>, num_classes> banks_{};
+};
+
+} /* namespace status */
+
+#endif /* STATUS_HPP */
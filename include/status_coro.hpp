@@ -0,0 +1,402 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_coro.hpp
+ *
+ * @brief C++20 awaitable that suspends a coroutine until a status edge.
+ *
+ * @details
+ *    Use change_waiters as the Observer of a status_register:
+ *
+ *        using reg_t = status::status_register<
+ *            12, std::uint16_t, status::change_waiters<12>>;
+ *        reg_t reg;
+ *
+ *        Word edges = co_await status::status_changed(reg, cls, bank, mask);
+ *        Word edges = co_await status::status_changed<overcurrent>(reg, ex);
+ *
+ *    The coroutine resumes after the next write that flips any bit of `mask`
+ *    in that bank (set or clear edge); the result is the bits that flipped.
+ *    The awaiter lives in the coroutine frame and is linked into a per-bank
+ *    intrusive list, so waiting allocates nothing. A write with no waiters
+ *    costs one atomic load; a write with waiters walks only the waiters of
+ *    its own bank.
+ *
+ *    Coroutines are resumed after the waiter lock has been released:
+ *    inline on the writing thread by default, or through `ex.post(handle)`
+ *    when an executor is given.
+ *
+ *    The awaiter captures the bank when status_changed() is called and
+ *    re-reads it once registered: if a watched bit flipped in between, the
+ *    coroutine does not suspend and gets those bits. To wait unless a
+ *    status is already set, create the awaiter before checking:
+ *
+ *        auto changed = status::status_changed<overcurrent>(reg);
+ *        if (!reg.is_set<overcurrent>()) {
+ *                co_await changed;
+ *        }
+ *
+ *    status_coro_c.hpp provides the same for the C library's register.
+ */
+
+#ifndef STATUS_CORO_HPP
+#define STATUS_CORO_HPP
+
+/* ================ INCLUDES ================================================ */
+
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "status.hpp"
+
+namespace status {
+
+/* ================ STRUCTURES ============================================== */
+
+/**
+ * @brief Intrusive waiter; embedded in every change_awaiter.
+ */
+template <class Word>
+struct change_node {
+        change_node *next = nullptr;
+        change_node *prev = nullptr;
+        Word mask = 0;
+        Word edges = 0;
+        bool linked = false;  /* on a bank's waiter list */
+        bool pending = false; /* woken by defer(), not yet dispatched */
+        std::coroutine_handle<> handle;
+        /* Executor hook, or nullptr to resume inline. */
+        void (*post)(void *, std::coroutine_handle<>) = nullptr;
+        void *ctx = nullptr;
+};
+
+/**
+ * @brief Register observer that wakes coroutines on matching edges.
+ *
+ * @tparam Banks Banks per class; must match the register.
+ * @tparam Word  Bank word; must match the register.
+ */
+template <std::size_t Banks, class Word = std::uint16_t>
+class change_waiters {
+    public:
+        using node = change_node<Word>;
+
+        /** Called by status_register after every bank write. */
+        void
+        on_change(id_class cls, std::size_t bank, Word old_val,
+                  Word new_val) noexcept
+        {
+                const Word diff = static_cast<Word>(old_val ^ new_val);
+                node *ready = nullptr;
+
+                if ((diff == Word{0}) || (waiting_.load() == 0u)) {
+                        return;
+                }
+
+                {
+                        std::lock_guard<std::mutex> guard(lock_);
+                        ready = take(cls, bank, diff);
+                }
+                wake(ready);
+        }
+
+        /**
+         * As on_change(), but the woken coroutines are only queued, to be
+         * resumed by dispatch(). For writers that must not run them, e.g.
+         * inside the C library's critical section.
+         */
+        void
+        defer(id_class cls, std::size_t bank, Word old_val,
+              Word new_val) noexcept
+        {
+                const Word diff = static_cast<Word>(old_val ^ new_val);
+
+                if ((diff == Word{0}) || (waiting_.load() == 0u)) {
+                        return;
+                }
+
+                std::lock_guard<std::mutex> guard(lock_);
+                node *n = take(cls, bank, diff);
+
+                while (n != nullptr) {
+                        node *next = n->next;
+
+                        n->prev = nullptr;
+                        n->next = pending_;
+                        if (pending_ != nullptr) {
+                                pending_->prev = n;
+                        }
+                        pending_ = n;
+                        n->pending = true;
+                        n = next;
+                }
+        }
+
+        /** Resume the coroutines queued by defer(); returns how many. */
+        std::size_t
+        dispatch() noexcept
+        {
+                node *ready = nullptr;
+                std::size_t count = 0u;
+
+                {
+                        std::lock_guard<std::mutex> guard(lock_);
+
+                        ready = pending_;
+                        pending_ = nullptr;
+                        for (node *n = ready; n != nullptr; n = n->next) {
+                                n->pending = false;
+                                ++count;
+                        }
+                }
+                wake(ready);
+                return count;
+        }
+
+        /** Link `n` as a waiter on (cls, bank). */
+        void
+        enqueue(id_class cls, std::size_t bank, node *n) noexcept
+        {
+                std::lock_guard<std::mutex> guard(lock_);
+                node *&head = heads_[static_cast<std::size_t>(cls)][bank];
+
+                n->prev = nullptr;
+                n->next = head;
+                if (head != nullptr) {
+                        head->prev = n;
+                }
+                head = n;
+                n->linked = true;
+                waiting_.fetch_add(1u);
+        }
+
+        /**
+         * Unlink `n` if it is still waiting or queued for dispatch() (e.g.
+         * its frame is destroyed). Returns false if a write is already
+         * resuming it.
+         */
+        bool
+        cancel(id_class cls, std::size_t bank, node *n) noexcept
+        {
+                std::lock_guard<std::mutex> guard(lock_);
+
+                if (n->linked) {
+                        unlink(cls, bank, n);
+                        return true;
+                }
+                if (n->pending) {
+                        if (n->prev != nullptr) {
+                                n->prev->next = n->next;
+                        } else {
+                                pending_ = n->next;
+                        }
+                        if (n->next != nullptr) {
+                                n->next->prev = n->prev;
+                        }
+                        n->pending = false;
+                        return true;
+                }
+                return false;
+        }
+
+        /** Number of coroutines currently waiting. */
+        std::size_t
+        waiting() const noexcept
+        {
+                return waiting_.load();
+        }
+
+    private:
+        /* Unlink the waiters of (cls, bank) matching `diff`; lock held. */
+        node *
+        take(id_class cls, std::size_t bank, Word diff) noexcept
+        {
+                node *ready = nullptr;
+                node *n = heads_[static_cast<std::size_t>(cls)][bank];
+
+                while (n != nullptr) {
+                        node *next = n->next;
+
+                        if ((n->mask & diff) != Word{0}) {
+                                unlink(cls, bank, n);
+                                n->edges = static_cast<Word>(n->mask & diff);
+                                n->next = ready;
+                                ready = n;
+                        }
+                        n = next;
+                }
+                return ready;
+        }
+
+        /* Resume or post a list from take(); lock released. */
+        static void
+        wake(node *ready) noexcept
+        {
+                /* The node is gone once its coroutine runs; read next first. */
+                while (ready != nullptr) {
+                        node *n = ready;
+
+                        ready = n->next;
+                        if (n->post != nullptr) {
+                                n->post(n->ctx, n->handle);
+                        } else {
+                                n->handle.resume();
+                        }
+                }
+        }
+
+        void
+        unlink(id_class cls, std::size_t bank, node *n) noexcept
+        {
+                node *&head = heads_[static_cast<std::size_t>(cls)][bank];
+
+                if (n->prev != nullptr) {
+                        n->prev->next = n->next;
+                } else {
+                        head = n->next;
+                }
+                if (n->next != nullptr) {
+                        n->next->prev = n->prev;
+                }
+                n->linked = false;
+                waiting_.fetch_sub(1u);
+        }
+
+        std::mutex lock_;
+        std::atomic<std::size_t> waiting_{0u};
+        node *pending_ = nullptr;
+        std::array<std::array<node *, Banks>, num_classes> heads_{};
+};
+
+/**
+ * @brief Awaitable returned by status_changed(); resumes with the flipped
+ *        bits of the watched mask.
+ */
+template <class Reg>
+class change_awaiter : private change_node<typename Reg::word_type> {
+        using Word = typename Reg::word_type;
+
+    public:
+        change_awaiter(Reg &reg, id_class cls, std::size_t bank, Word mask,
+                       void (*post)(void *, std::coroutine_handle<>),
+                       void *ctx) noexcept
+            : reg_(reg), cls_(cls), bank_(bank)
+        {
+                this->mask = mask;
+                this->post = post;
+                this->ctx = ctx;
+                if (bank < Reg::num_banks) {
+                        seen_ = reg.load(cls, bank);
+                }
+        }
+
+        change_awaiter(const change_awaiter &) = delete;
+        change_awaiter &operator=(const change_awaiter &) = delete;
+
+        ~change_awaiter()
+        {
+                reg_.observer().cancel(cls_, bank_, this);
+        }
+
+        /* Nothing to wait for: empty mask or a bank outside the register. */
+        bool
+        await_ready() const noexcept
+        {
+                return (this->mask == Word{0}) || (bank_ >= Reg::num_banks);
+        }
+
+        /* Stays suspended unless a watched bit flipped since construction. */
+        bool
+        await_suspend(std::coroutine_handle<> h) noexcept
+        {
+                auto &w = reg_.observer();
+
+                this->handle = h;
+                w.enqueue(cls_, bank_, this);
+
+                const Word flipped = static_cast<Word>(
+                    (reg_.load(cls_, bank_) ^ seen_) & this->mask);
+
+                /* A write that already unlinked us will resume us. */
+                if ((flipped != Word{0}) && w.cancel(cls_, bank_, this)) {
+                        this->edges = flipped;
+                        return false;
+                }
+                return true;
+        }
+
+        Word
+        await_resume() const noexcept
+        {
+                return this->edges;
+        }
+
+    private:
+        Reg &reg_;
+        id_class cls_;
+        std::size_t bank_;
+        Word seen_ = 0; /* bank as of status_changed() */
+};
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+/**
+ * @brief Wait for the next edge on any bit of `mask` in (cls, bank),
+ *        resuming inline on the writing thread.
+ */
+template <class Reg>
+change_awaiter<Reg>
+status_changed(Reg &reg, id_class cls, std::size_t bank,
+               typename Reg::word_type mask) noexcept
+{
+        return {reg, cls, bank, mask, nullptr, nullptr};
+}
+
+/**
+ * @brief As above, resuming through `ex.post(std::coroutine_handle<>)`.
+ */
+template <class Reg, class Executor>
+change_awaiter<Reg>
+status_changed(Reg &reg, id_class cls, std::size_t bank,
+               typename Reg::word_type mask, Executor &ex) noexcept
+{
+        return {reg, cls, bank, mask,
+                [](void *e, std::coroutine_handle<> h) {
+                        static_cast<Executor *>(e)->post(h);
+                },
+                &ex};
+}
+
+/**
+ * @brief Wait for the next set or clear edge of the typed ID `Id`.
+ */
+template <class Id, class Reg>
+change_awaiter<Reg>
+status_changed(Reg &reg) noexcept
+{
+        static_assert(Id::bank < Reg::num_banks, "status ID bank out of range");
+        static_assert(Id::bit < Reg::bits_per_bank, "status ID bit out of range");
+        return status_changed(reg, Id::cls, Id::bank,
+                              static_cast<typename Reg::word_type>(
+                                  typename Reg::word_type{1} << Id::bit));
+}
+
+template <class Id, class Reg, class Executor>
+change_awaiter<Reg>
+status_changed(Reg &reg, Executor &ex) noexcept
+{
+        static_assert(Id::bank < Reg::num_banks, "status ID bank out of range");
+        static_assert(Id::bit < Reg::bits_per_bank, "status ID bit out of range");
+        return status_changed(reg, Id::cls, Id::bank,
+                              static_cast<typename Reg::word_type>(
+                                  typename Reg::word_type{1} << Id::bit),
+                              ex);
+}
+
+} /* namespace status */
+
+#endif /* STATUS_CORO_HPP */
@@ -0,0 +1,133 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_coro_c.hpp
+ *
+ * @brief C++20 awaitable for edges of the C library's register.
+ *
+ * @details
+ *    c_register installs itself as the library's edge hook
+ *    (STATUS_ENABLE_EDGE_HOOK), so every bank change made through the C API
+ *    reaches the same per-bank waiter lists as status_coro.hpp:
+ *
+ *        status::c_register reg;
+ *
+ *        std::uint16_t edges = co_await status::status_changed(
+ *            reg, status::id_class::fault, STATUS_ID_FAULT_OVERCURRENT);
+ *
+ *    The hook runs inside the library's critical section, where no
+ *    coroutine may run. It only moves the matching waiters to a queue;
+ *    reg.dispatch(), called from the task that should run them, resumes
+ *    them inline or through the executor given to status_changed().
+ *
+ *    One c_register per program; it removes the hook when destroyed.
+ *
+ * @note Requires STATUS_ENABLE_EDGE_HOOK and linking the C library.
+ */
+
+#ifndef STATUS_CORO_C_HPP
+#define STATUS_CORO_C_HPP
+
+/* ================ INCLUDES ================================================ */
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+#include "status.h"
+#include "status_coro.hpp"
+
+#if !STATUS_ENABLE_EDGE_HOOK
+#error "status_coro_c.hpp requires STATUS_ENABLE_EDGE_HOOK"
+#endif
+
+namespace status {
+
+/* ================ STRUCTURES ============================================== */
+
+/**
+ * @brief The C library's register as a source of awaitable edges.
+ */
+class c_register {
+    public:
+        using word_type = std::uint16_t;
+        using observer_type = change_waiters<NUM_STATUS_BANKS, word_type>;
+        static constexpr std::size_t num_banks = NUM_STATUS_BANKS;
+        static constexpr unsigned bits_per_bank = 16u;
+
+        c_register() noexcept
+        {
+                status_set_edge_hook(&c_register::hook, this);
+        }
+
+        ~c_register()
+        {
+                status_set_edge_hook(nullptr, nullptr);
+        }
+
+        c_register(const c_register &) = delete;
+        c_register &operator=(const c_register &) = delete;
+
+        /** Current word of (cls, bank); `bank` must be below num_banks. */
+        word_type
+        load(id_class cls, std::size_t bank) const noexcept
+        {
+                return status_field_get(static_cast<enum status_class>(cls),
+                                        STATUS_FIELD(bank, 0u, 16u));
+        }
+
+        /** Resume the coroutines woken since the last call; returns how many. */
+        std::size_t
+        dispatch() noexcept
+        {
+                return waiters_.dispatch();
+        }
+
+        /** The waiter lists, as for status_register::observer(). */
+        observer_type &
+        observer() noexcept
+        {
+                return waiters_;
+        }
+
+    private:
+        static void
+        hook(enum status_class cls, std::uint16_t bank, std::uint16_t old_val,
+             std::uint16_t new_val, void *ctx)
+        {
+                static_cast<c_register *>(ctx)->waiters_.defer(
+                    static_cast<id_class>(cls), bank, old_val, new_val);
+        }
+
+        observer_type waiters_;
+};
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+/**
+ * @brief Wait for the next set or clear edge of the C status ID `id`.
+ */
+inline change_awaiter<c_register>
+status_changed(c_register &reg, id_class cls, std::uint16_t id) noexcept
+{
+        return status_changed(reg, cls, status_bank(id),
+                              static_cast<std::uint16_t>(1u << status_bit(id)));
+}
+
+/**
+ * @brief As above, resuming through `ex.post(std::coroutine_handle<>)`.
+ */
+template <class Executor>
+        requires requires(Executor &e, std::coroutine_handle<> h) { e.post(h); }
+change_awaiter<c_register>
+status_changed(c_register &reg, id_class cls, std::uint16_t id,
+               Executor &ex) noexcept
+{
+        return status_changed(reg, cls, status_bank(id),
+                              static_cast<std::uint16_t>(1u << status_bit(id)),
+                              ex);
+}
+
+} /* namespace status */
+
+#endif /* STATUS_CORO_C_HPP */
@@ -0,0 +1,123 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_deadline.h
+ *
+ * @brief Deadline monitor that raises a status bit when a periodic event
+ *        (heartbeat, CAN frame, ...) fails to arrive in time.
+ */
+
+#ifndef STATUS_DEADLINE_H
+#define STATUS_DEADLINE_H
+
+/* Add C bindings if being compiled with C++ compiler */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+
+/* ================ DEFINES ================================================= */
+
+/* ---------------  Configuration ------------------------------------------- */
+
+/**
+ * @def STATUS_DEADLINE_MAX
+ * @brief Maximum number of concurrently monitored signals.
+ *
+ * @details
+ *    Storage is allocated statically: roughly 16 bytes per slot.
+ */
+#ifndef STATUS_DEADLINE_MAX
+#define STATUS_DEADLINE_MAX (16u)
+#endif
+
+/**
+ * @def STATUS_DEADLINE_INVALID
+ * @brief Handle returned by status_deadline_register() when no slot is free
+ *        or the arguments are rejected.
+ */
+#define STATUS_DEADLINE_INVALID (0xFFFFu)
+
+/* ================ TYPEDEFS ================================================ */
+
+/**
+ * @brief Handle identifying a monitored signal.
+ */
+typedef uint16_t status_deadline_t;
+
+/* ================ GLOBAL PROTOTYPES ======================================= */
+
+/**
+ * @brief Initialise the deadline monitor, releasing every slot.
+ *
+ * @note Status bits previously raised by the monitor are left untouched.
+ */
+void status_deadline_init(void);
+
+/**
+ * @brief Start monitoring a periodic event.
+ *
+ * @param cls       Class of the status bit raised on expiry.
+ * @param id        Status ID raised on expiry.
+ * @param period    Maximum allowed gap between two kicks, in ticks (> 0).
+ * @param now       Current time; the first deadline is `now + period`.
+ *
+ * @return          A handle for status_deadline_kick(), or
+ *                  STATUS_DEADLINE_INVALID if the table is full, `cls` is
+ *                  not a valid class, `id` lies outside NUM_STATUS_BANKS or
+ *                  `period` is zero or >= 2^31.
+ */
+status_deadline_t status_deadline_register(enum status_class cls, uint16_t id,
+                                           status_time_t period,
+                                           status_time_t now);
+
+/**
+ * @brief Stop monitoring and release the slot.
+ *
+ * @note The status bit is not modified.
+ */
+void status_deadline_unregister(status_deadline_t h);
+
+/**
+ * @brief Report that the monitored event occurred, re-arming its deadline.
+ *
+ * @details
+ *    O(log STATUS_DEADLINE_MAX). If the deadline had already lapsed, the
+ *    monitor clears the status bit it raised (the signal has recovered).
+ *    `now` may be earlier than the previous kick (e.g. a clock reset).
+ *
+ * @note May race with status_deadline_tick() from another context: the
+ *       status bit always ends up matching status_deadline_expired().
+ */
+void status_deadline_kick(status_deadline_t h, status_time_t now);
+
+/**
+ * @brief Raise the status bit of every signal whose deadline has lapsed.
+ *
+ * @details
+ *    Deadlines are kept in a min-heap, so the cost is proportional to the
+ *    number of expirations (O(k log n)), not to the number of monitored
+ *    signals. Call periodically from the main loop or a timer task.
+ *
+ * @return          Number of signals that expired during this call.
+ */
+size_t status_deadline_tick(status_time_t now);
+
+/**
+ * @brief Check whether a monitored signal is currently expired.
+ */
+bool status_deadline_expired(status_deadline_t h);
+
+/* End of C bindings for C++ compilers */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_DEADLINE_H */
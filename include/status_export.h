@@ -0,0 +1,117 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_export.h
+ *
+ * @brief Allocation-free, resumable JSON/CBOR serialiser for the active
+ *        status IDs of all three classes.
+ */
+
+#ifndef STATUS_EXPORT_H
+#define STATUS_EXPORT_H
+
+/* Add C bindings if being compiled with C++ compiler */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+
+/* ================ TYPEDEFS ================================================ */
+
+/**
+ * @brief Output encodings.
+ *
+ * @details
+ *    Without names:
+ *      JSON  {"fault":[0,1],"warning":[],"info":[32]}
+ *      CBOR  {"fault":[0,1],"warning":[],"info":[32]} (definite lengths)
+ *
+ *    With names, IDs whose name callback returns non-NULL become:
+ *      JSON  {"id":0,"name":"FAULT_OVERCURRENT"}
+ *      CBOR  [0,"FAULT_OVERCURRENT"]
+ *    IDs without a name are emitted as a bare number in both formats.
+ */
+enum status_export_format {
+        STATUS_EXPORT_JSON = 0,
+        STATUS_EXPORT_CBOR,
+};
+
+/**
+ * @brief Optional name provider, e.g. status_id_to_name() from
+ *        status_names.h. Returning NULL emits the bare ID.
+ */
+typedef const char *(*status_export_name_fn)(enum status_class cls,
+                                             uint16_t id);
+
+/* ================ STRUCTURES ============================================== */
+
+/**
+ * @brief Exporter state. Treat as opaque; allocate it wherever convenient
+ *        (stack, static) - it holds a snapshot of every bank.
+ */
+struct status_exporter {
+        uint16_t banks[3][NUM_STATUS_BANKS]; /* snapshot taken at begin */
+        uint16_t count[3];                   /* active IDs per class */
+        status_export_name_fn name_fn;
+        const char *name;                    /* name being streamed */
+        size_t name_len;
+        size_t name_off;
+        uint32_t pos;                        /* next dense ID to scan */
+        uint16_t emitted;                    /* items emitted in class */
+        uint8_t fmt;
+        uint8_t cls;
+        uint8_t state;
+        uint8_t pend_len;
+        uint8_t pend_off;
+        uint8_t pend[24];                    /* token not yet written */
+};
+
+/* ================ GLOBAL PROTOTYPES ======================================= */
+
+/**
+ * @brief Snapshot the registers and start a new document.
+ *
+ * @param x         Exporter state to (re)initialise.
+ * @param fmt       Output encoding.
+ * @param name_fn   Name provider, or NULL to emit IDs only.
+ *
+ * @note Each class is copied under its own critical section, as with
+ *       status_snapshot(); the document reflects that snapshot no matter how
+ *       many status_export_step() calls it takes to drain.
+ */
+void status_export_begin(struct status_exporter *x,
+                         enum status_export_format fmt,
+                         status_export_name_fn name_fn);
+
+/**
+ * @brief Write the next chunk of the document.
+ *
+ * @details
+ *    Fills `dst` with up to `cap` bytes and returns the number written.
+ *    Output stops exactly at `cap`; the next call resumes mid-token, so any
+ *    buffer size (including 1) works. No allocation, no snprintf.
+ *
+ * @return          Bytes written; 0 once the document is complete or if
+ *                  `x`/`dst` is NULL.
+ */
+size_t status_export_step(struct status_exporter *x, uint8_t *dst,
+                          size_t cap);
+
+/**
+ * @brief True once every byte of the document has been returned.
+ */
+bool status_export_done(const struct status_exporter *x);
+
+/* End of C bindings for C++ compilers */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_EXPORT_H */
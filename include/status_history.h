@@ -0,0 +1,131 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_history.h
+ *
+ * @brief Bounded in-RAM history of the register with point-in-time
+ *        reconstruction.
+ *
+ * @details
+ *    status_history_sample() is called periodically (e.g. from a 100 ms
+ *    task). Each sample that changed anything stores one delta per changed
+ *    bank: the sample time, the bank and the XOR of its old and new value.
+ *    Every STATUS_HISTORY_DELTAS deltas a full checkpoint of all three
+ *    classes is taken instead. Samples with no change cost no memory, so a
+ *    quiet system keeps hours of history in a few kilobytes.
+ *
+ *    Storage is STATUS_HISTORY_CHECKPOINTS segments of one checkpoint plus
+ *    up to STATUS_HISTORY_DELTAS deltas. When all segments are in use the
+ *    oldest one is evicted. status_history_at() binary-searches the
+ *    segments by time and replays at most STATUS_HISTORY_DELTAS deltas.
+ *
+ *    The history has the resolution of the sampling period: a status that
+ *    is set and cleared between two samples is not seen. Times are
+ *    compared modulo 2^32, so the retained history must span less than
+ *    2^31 ticks.
+ */
+
+#ifndef STATUS_HISTORY_H
+#define STATUS_HISTORY_H
+
+/* Add C bindings if being compiled with C++ compiler */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+
+/* ================ DEFINES ================================================= */
+
+/* ---------------  Configuration ------------------------------------------- */
+
+/**
+ * @def STATUS_HISTORY_CHECKPOINTS
+ * @brief Number of checkpoint segments kept (>= 2).
+ *
+ * @details
+ *    Each segment takes about 8 + 6 * NUM_STATUS_BANKS
+ *    + 8 * STATUS_HISTORY_DELTAS bytes; the module adds
+ *    12 * NUM_STATUS_BANKS bytes of working state.
+ */
+#ifndef STATUS_HISTORY_CHECKPOINTS
+#define STATUS_HISTORY_CHECKPOINTS (8u)
+#endif
+
+/**
+ * @def STATUS_HISTORY_DELTAS
+ * @brief Bank deltas stored between two checkpoints.
+ *
+ * @details
+ *    Bounds the replay cost of status_history_at(). Larger values favour
+ *    memory (a delta is 8 bytes, a checkpoint 6 * NUM_STATUS_BANKS),
+ *    smaller values favour query time.
+ */
+#ifndef STATUS_HISTORY_DELTAS
+#define STATUS_HISTORY_DELTAS (32u)
+#endif
+
+/* ================ GLOBAL PROTOTYPES ======================================= */
+
+/**
+ * @brief Discard the whole history.
+ */
+void status_history_init(void);
+
+/**
+ * @brief Record the current register state at time `now`.
+ *
+ * @param now       Sample time; must not go backwards.
+ *
+ * @return          Number of banks that changed since the previous sample
+ *                  (all non-zero banks for the first one).
+ *
+ * @details
+ *    Each class is read with status_snapshot(), so the three classes are
+ *    individually but not jointly consistent. Call from one context only.
+ *    O(NUM_STATUS_BANKS); a checkpoint copies 6 * NUM_STATUS_BANKS bytes
+ *    inside the critical section.
+ */
+size_t status_history_sample(status_time_t now);
+
+/**
+ * @brief Reconstruct the banks of a class as sampled at time `t`.
+ *
+ * @param t         Point in time. Between two samples, the state of the
+ *                  earlier one is returned; after the latest sample, the
+ *                  latest state.
+ * @param cls       The class of status.
+ * @param dst       Receives NUM_STATUS_BANKS words.
+ *
+ * @return          True if `dst` was written; false if `t` is older than
+ *                  the retained history, nothing has been sampled yet,
+ *                  `cls` is invalid or `dst` is NULL.
+ *
+ * @details
+ *    O(log STATUS_HISTORY_CHECKPOINTS + STATUS_HISTORY_DELTAS
+ *    + NUM_STATUS_BANKS), under a single read section.
+ */
+bool status_history_at(status_time_t t, enum status_class cls, uint16_t *dst);
+
+/**
+ * @brief Time span currently covered by the history.
+ *
+ * @param first     Receives the time of the oldest retained checkpoint.
+ * @param last      Receives the time of the latest sample.
+ *
+ * @return          False (outputs untouched) if nothing has been sampled.
+ */
+bool status_history_span(status_time_t *first, status_time_t *last);
+
+/* End of C bindings for C++ compilers */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_HISTORY_H */
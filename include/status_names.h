@@ -0,0 +1,120 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_names.h
+ *
+ * @brief O(1) name <-> ID lookup over the tables generated by
+ *        tools/status_gen.py.
+ *
+ * @note Link src/status_names.c together with the generated status_ids.c.
+ */
+
+#ifndef STATUS_NAMES_H
+#define STATUS_NAMES_H
+
+/* Add C bindings if being compiled with C++ compiler */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+
+/* ================ STRUCTURES ============================================== */
+
+/**
+ * @brief One slot of the generated minimal perfect hash table.
+ */
+struct status_name_entry {
+        const char *name; /**< Name without the STATUS_ID_ prefix */
+        uint16_t id;      /**< Encoded status ID */
+        uint8_t cls;      /**< enum status_class value */
+};
+
+/**
+ * @brief Generated lookup tables, emitted as `status_name_table` in the
+ *        generated status_ids.c.
+ */
+struct status_name_map {
+        const char *const *names[3];            /**< Dense ID-to-name, per class */
+        size_t names_len;                       /**< Entries per class */
+        const uint16_t *disp;                   /**< Per-bucket displacement */
+        size_t buckets;                         /**< Number of buckets */
+        const struct status_name_entry *slots;  /**< One slot per name */
+        size_t count;                           /**< Number of names */
+};
+
+/* ================ GLOBAL VARIABLES ======================================== */
+
+/**
+ * @brief Tables of the application's generated status_ids.c.
+ */
+extern const struct status_name_map status_name_table;
+
+/* ================ GLOBAL PROTOTYPES ======================================= */
+
+/**
+ * @brief Seeded 32-bit FNV-1a hash with a final avalanche step.
+ *
+ * @param s         Name characters (need not be NUL-terminated).
+ * @param len       Number of characters.
+ * @param seed      0 selects the bucket; the bucket's displacement selects
+ *                  the slot.
+ *
+ * @note tools/status_gen.py implements the same function; the two must stay
+ *       bit-for-bit identical.
+ */
+static inline uint32_t
+status_name_hash(const char *s, size_t len, uint32_t seed)
+{
+        uint32_t h = 2166136261u ^ seed;
+
+        for (size_t i = 0u; i < len; ++i) {
+                h ^= (uint32_t)(unsigned char)s[i];
+                h *= 16777619u;
+        }
+        h ^= h >> 15u;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12u;
+
+        return h;
+}
+
+/**
+ * @brief Resolve a status name to its class and ID.
+ *
+ * @details
+ *    One hash for the bucket, one for the slot and a single string compare;
+ *    the cost does not depend on the number of defined IDs. An optional
+ *    `STATUS_ID_` prefix is accepted, so both `FAULT_OVERCURRENT` and
+ *    `STATUS_ID_FAULT_OVERCURRENT` resolve.
+ *
+ * @param name      Name characters (need not be NUL-terminated).
+ * @param len       Number of characters in `name`.
+ * @param cls       Receives the class on success (may be NULL).
+ * @param id        Receives the ID on success (may be NULL).
+ *
+ * @return          true if the name is defined; `cls` and `id` are left
+ *                  untouched otherwise.
+ */
+bool status_name_to_id(const char *name, size_t len, enum status_class *cls,
+                       uint16_t *id);
+
+/**
+ * @brief Name of a status ID, without the `STATUS_ID_` prefix.
+ *
+ * @return          The name, or NULL if `cls`/`id` is not defined.
+ */
+const char *status_id_to_name(enum status_class cls, uint16_t id);
+
+/* End of C bindings for C++ compilers */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_NAMES_H */
@@ -0,0 +1,169 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_persist.h
+ *
+ * @brief Append-only log of changed banks in non-volatile memory, with
+ *        background compaction and single-scan restore.
+ *
+ * @details
+ *    The status writers only mark changed banks (STATUS_ENABLE_DIRTY, one
+ *    OR per write). status_persist_step(), called from a background task,
+ *    collects the marked banks and appends one 8-byte record per bank to
+ *    the active log area:
+ *
+ *      class(1) reserved(1) bank(2) value(2) crc16(2)   little-endian
+ *
+ *    The storage is two areas of `area_size` bytes that are erased to 0xFF
+ *    and programmed sequentially, like two flash sectors (or a file per
+ *    area on a host build). An area holds a header, a snapshot of every
+ *    non-zero bank, a commit record and then the appended records. Once
+ *    the active area reaches `compact_at` bytes, the next steps write a
+ *    fresh snapshot to the other area; its commit record makes it the
+ *    active one. Only the snapshot is ever rewritten, and only once per
+ *    `compact_at - snapshot` bytes of changes.
+ *
+ *    status_persist_open() reads the two headers, then scans the newest
+ *    committed area once from start to end, keeping the last value of each
+ *    bank, and writes the result to the register. The scan stops at the
+ *    first erased or corrupt record, so a record torn by a reset is
+ *    dropped together with anything after it; a torn tail is compacted
+ *    away before the next append.
+ *
+ *    Not thread-safe: call open and step from one context. The register
+ *    itself may be written from anywhere at any time.
+ *
+ * @note The persistence sources (src/status_persist.c) are built
+ *       separately from the core library and require STATUS_ENABLE_DIRTY.
+ */
+
+#ifndef STATUS_PERSIST_H
+#define STATUS_PERSIST_H
+
+/* Add C bindings if being compiled with C++ compiler */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+
+/* ================ DEFINES ================================================= */
+
+/**
+ * @def STATUS_PERSIST_REC_SIZE
+ * @brief Bytes per log record (and per area header).
+ */
+#define STATUS_PERSIST_REC_SIZE (8u)
+
+/**
+ * @def STATUS_PERSIST_SNAPSHOT_MAX
+ * @brief Largest compacted area: header, every bank of every class, commit.
+ *        `compact_at` must exceed it.
+ */
+#define STATUS_PERSIST_SNAPSHOT_MAX \
+        (STATUS_PERSIST_REC_SIZE * (2u + (3u * (uint32_t)NUM_STATUS_BANKS)))
+
+/* ================ TYPEDEFS ================================================ */
+
+/**
+ * @brief Read `len` bytes at offset `off` of area 0 or 1.
+ * @return          False on a device error.
+ */
+typedef bool (*status_nvm_read_fn)(void *ctx, uint8_t area, uint32_t off,
+                                   void *dst, size_t len);
+
+/**
+ * @brief Program `len` bytes at offset `off` of an area. The range has been
+ *        erased and is written at most once between two erases.
+ * @return          False on a device error.
+ */
+typedef bool (*status_nvm_write_fn)(void *ctx, uint8_t area, uint32_t off,
+                                    const void *src, size_t len);
+
+/**
+ * @brief Erase a whole area to 0xFF.
+ * @return          False on a device error.
+ */
+typedef bool (*status_nvm_erase_fn)(void *ctx, uint8_t area);
+
+/* ================ STRUCTURES ============================================== */
+
+/**
+ * @brief Storage backend and log geometry.
+ */
+struct status_persist_cfg {
+        status_nvm_read_fn read;
+        status_nvm_write_fn write;
+        status_nvm_erase_fn erase;
+        void *ctx;           /* passed to every callback */
+        uint32_t area_size;  /* bytes per area */
+        uint32_t compact_at; /* compact once the active area holds this many
+                                bytes; STATUS_PERSIST_SNAPSHOT_MAX <
+                                compact_at <= area_size */
+};
+
+/* ================ GLOBAL PROTOTYPES ======================================= */
+
+/**
+ * @brief Attach the backend and restore the persisted state.
+ *
+ * @param cfg       Backend and geometry; copied.
+ *
+ * @return          False if `cfg` is NULL or invalid, the storage could not
+ *                  be read, or a device error prevented formatting blank
+ *                  storage.
+ *
+ * @details
+ *    Call after status_init() and before the register is written. The
+ *    newest committed area is replayed into the register with
+ *    status_field_set(), so debounce and the last-set IDs are bypassed but
+ *    the edge features see the restored bits, and the dirty marks are then
+ *    cleared. Storage that was read but holds no committed log (blank,
+ *    foreign or never finished formatting) is formatted with an empty
+ *    snapshot and restores nothing. A read error leaves the storage
+ *    untouched and the log closed; open again once the device recovers.
+ */
+bool status_persist_open(const struct status_persist_cfg *cfg);
+
+/**
+ * @brief Background work: append changed banks or advance a compaction.
+ *
+ * @param budget    Upper bound on the work done: records appended, or
+ *                  banks visited while compacting.
+ *
+ * @return          Work done, 0 if there was nothing to do, the log is not
+ *                  open or the device failed.
+ *
+ * @details
+ *    While a compaction is in progress nothing is appended; banks changed
+ *    meanwhile stay marked and are appended after its commit. A failed
+ *    append starts a compaction (the snapshot covers the lost record); a
+ *    failed compaction is retried from the start on the next call.
+ */
+size_t status_persist_step(size_t budget);
+
+/**
+ * @brief Run status_persist_step() until every changed bank is stored,
+ *        e.g. before a controlled shutdown.
+ *
+ * @return          False if the log is not open or the device failed.
+ */
+bool status_persist_sync(void);
+
+/**
+ * @brief Bytes used in the active area, header and snapshot included.
+ */
+uint32_t status_persist_used(void);
+
+/* End of C bindings for C++ compilers */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_PERSIST_H */
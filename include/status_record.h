@@ -0,0 +1,197 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_record.h
+ *
+ * @brief On-disk formats shared by the firmware and the host tools: register
+ *        dump images and flight-recorder transition streams.
+ *
+ * @details
+ *    All multi-byte fields are little-endian regardless of the target, so
+ *    files can be decoded on any host. Use the pack/unpack helpers rather than
+ *    writing the structures directly.
+ *
+ *    Dump image:
+ *        status_dump_header, then u16 banks[3][num_banks] (fault, warning,
+ *        info), then u16 last_id[3].
+ *
+ *    Flight recording:
+ *        status_rec_header, then a stream of STATUS_REC_SIZE-byte records.
+ */
+
+#ifndef STATUS_RECORD_H
+#define STATUS_RECORD_H
+
+/* Add C bindings if being compiled with C++ compiler */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================ INCLUDES ================================================ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ================ DEFINES ================================================= */
+
+#define STATUS_DUMP_MAGIC   (0x50445453u) /* "STDP" */
+#define STATUS_REC_MAGIC    (0x43525453u) /* "STRC" */
+#define STATUS_REC_VERSION  (1u)
+
+/** Size of the dump / recording file headers, in bytes. */
+#define STATUS_DUMP_HDR_SIZE (8u)
+#define STATUS_REC_HDR_SIZE  (12u)
+
+/** Size of one packed record, in bytes. */
+#define STATUS_REC_SIZE (12u)
+
+/** Initial value for status_record_hash(). */
+#define STATUS_REC_HASH_INIT (2166136261u)
+
+/* ================ TYPEDEFS ================================================ */
+
+/**
+ * @brief Recorded operations.
+ */
+enum status_rec_op {
+        STATUS_REC_SET = 1,       /**< status_set_*(id) */
+        STATUS_REC_CLEAR = 2,     /**< status_clear_*(id) */
+        STATUS_REC_CLEAR_ALL = 3, /**< status_clear_all(cls); id unused */
+        STATUS_REC_CHECKPOINT = 4 /**< value = status_record_hash() of all
+                                       three classes; id and cls unused */
+};
+
+/* ================ STRUCTURES ============================================== */
+
+/**
+ * @brief Header of a dump image.
+ */
+struct status_dump_header {
+        uint32_t magic;     /**< STATUS_DUMP_MAGIC */
+        uint16_t version;   /**< STATUS_REC_VERSION */
+        uint16_t num_banks; /**< NUM_STATUS_BANKS of the producer */
+};
+
+/**
+ * @brief Header of a flight recording.
+ */
+struct status_rec_header {
+        uint32_t magic;       /**< STATUS_REC_MAGIC */
+        uint16_t version;     /**< STATUS_REC_VERSION */
+        uint16_t num_banks;   /**< NUM_STATUS_BANKS of the producer */
+        uint32_t record_size; /**< STATUS_REC_SIZE */
+};
+
+/**
+ * @brief One recorded transition.
+ */
+struct status_record {
+        uint32_t time;  /**< status_time_t of the operation */
+        uint16_t id;    /**< Status ID */
+        uint8_t cls;    /**< enum status_class */
+        uint8_t op;     /**< enum status_rec_op */
+        uint32_t value; /**< Checkpoint hash, otherwise 0 */
+};
+
+/* ================ GLOBAL PROTOTYPES ======================================= */
+
+static inline void
+status_le16_put(uint8_t *p, uint16_t v)
+{
+        p[0] = (uint8_t)v;
+        p[1] = (uint8_t)(v >> 8u);
+}
+
+static inline void
+status_le32_put(uint8_t *p, uint32_t v)
+{
+        status_le16_put(p, (uint16_t)v);
+        status_le16_put(&p[2], (uint16_t)(v >> 16u));
+}
+
+static inline uint16_t
+status_le16_get(const uint8_t *p)
+{
+        return (uint16_t)(p[0] | ((uint16_t)p[1] << 8u));
+}
+
+static inline uint32_t
+status_le32_get(const uint8_t *p)
+{
+        return (uint32_t)status_le16_get(p)
+               | ((uint32_t)status_le16_get(&p[2]) << 16u);
+}
+
+/**
+ * @brief Serialise a record into STATUS_REC_SIZE bytes.
+ */
+static inline void
+status_record_pack(uint8_t *dst, const struct status_record *r)
+{
+        status_le32_put(dst, r->time);
+        status_le16_put(&dst[4], r->id);
+        dst[6] = r->cls;
+        dst[7] = r->op;
+        status_le32_put(&dst[8], r->value);
+}
+
+/**
+ * @brief Deserialise STATUS_REC_SIZE bytes into a record.
+ */
+static inline void
+status_record_unpack(struct status_record *r, const uint8_t *src)
+{
+        r->time = status_le32_get(src);
+        r->id = status_le16_get(&src[4]);
+        r->cls = src[6];
+        r->op = src[7];
+        r->value = status_le32_get(&src[8]);
+}
+
+/**
+ * @brief Serialise a dump image header into STATUS_DUMP_HDR_SIZE bytes.
+ */
+static inline void
+status_dump_header_pack(uint8_t *dst, uint16_t num_banks)
+{
+        status_le32_put(dst, STATUS_DUMP_MAGIC);
+        status_le16_put(&dst[4], STATUS_REC_VERSION);
+        status_le16_put(&dst[6], num_banks);
+}
+
+/**
+ * @brief Serialise a recording header into STATUS_REC_HDR_SIZE bytes.
+ */
+static inline void
+status_rec_header_pack(uint8_t *dst, uint16_t num_banks)
+{
+        status_le32_put(dst, STATUS_REC_MAGIC);
+        status_le16_put(&dst[4], STATUS_REC_VERSION);
+        status_le16_put(&dst[6], num_banks);
+        status_le32_put(&dst[8], STATUS_REC_SIZE);
+}
+
+/**
+ * @brief FNV-1a over the little-endian bytes of `n` banks.
+ *
+ * @details
+ *    Chain the three classes in fault, warning, info order starting from
+ *    STATUS_REC_HASH_INIT to obtain a checkpoint value.
+ */
+static inline uint32_t
+status_record_hash(const uint16_t *banks, size_t n, uint32_t h)
+{
+        for (size_t i = 0u; i < n; ++i) {
+                h = (h ^ (banks[i] & 0xFFu)) * 16777619u;
+                h = (h ^ (uint32_t)(banks[i] >> 8u)) * 16777619u;
+        }
+
+        return h;
+}
+
+/* End of C bindings for C++ compilers */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_RECORD_H */
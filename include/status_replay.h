@@ -0,0 +1,91 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_replay.h
+ *
+ * @brief Replays a flight recording (see status_record.h) through the public
+ *        set/clear API and verifies its checkpoints.
+ */
+
+#ifndef STATUS_REPLAY_H
+#define STATUS_REPLAY_H
+
+/* Add C bindings if being compiled with C++ compiler */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+
+/* ================ TYPEDEFS ================================================ */
+
+/**
+ * @brief Pacing hook called before each record.
+ *
+ * @param delta     Recorded ticks since the previous record (0 for the
+ *                  first one).
+ * @param ctx       Caller context passed to status_replay().
+ *
+ * @note Sleep for `delta` scaled to real time to reproduce the original
+ *       timing, or pass NULL to status_replay() to run at full speed.
+ */
+typedef void (*status_replay_wait_fn)(status_time_t delta, void *ctx);
+
+/* ================ STRUCTURES ============================================== */
+
+/**
+ * @brief Outcome of a replay.
+ */
+struct status_replay_result {
+        size_t events;         /**< Records processed */
+        size_t invalid;        /**< Records with a bad class, op or bank */
+        size_t checkpoints;    /**< Checkpoints compared */
+        size_t mismatches;     /**< Checkpoints that did not match */
+        size_t first_mismatch; /**< Record index of the first mismatch,
+                                    or SIZE_MAX */
+};
+
+/* ================ GLOBAL PROTOTYPES ======================================= */
+
+/**
+ * @brief Feed a recording into the register.
+ *
+ * @details
+ *    Each set/clear/clear_all record calls the matching status_set_*(),
+ *    status_clear_*() or status_clear_all(); each checkpoint takes a
+ *    status_snapshot() of all classes and compares status_record_hash()
+ *    with the recorded value. The register is not reset first - call
+ *    status_init() to start from the same state as the recording.
+ *
+ * @param rec       Recording, header included (e.g. an mmap'ed file).
+ * @param len       Length of `rec` in bytes; a trailing partial record is
+ *                  ignored.
+ * @param wait      Pacing hook, or NULL for full speed.
+ * @param ctx       Passed to `wait`.
+ * @param res       Receives the counters (required).
+ *
+ * @return          false if the header is missing, has another version,
+ *                  record size or NUM_STATUS_BANKS, or if `rec`/`res` is
+ *                  NULL; nothing is replayed in that case.
+ */
+bool status_replay(const uint8_t *rec, size_t len, status_replay_wait_fn wait,
+                   void *ctx, struct status_replay_result *res);
+
+/**
+ * @brief status_record_hash() of the current contents of all three classes,
+ *        as stored in STATUS_REC_CHECKPOINT records.
+ */
+uint32_t status_replay_checkpoint(void);
+
+/* End of C bindings for C++ compilers */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATUS_REPLAY_H */
@@ -13,6 +13,11 @@
 #include <stdint.h>
 
 #include "status.h"
+#include "status_bits.h"
+
+#if !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#endif
 
 /* ================ DEFINES ================================================= */
 
@@ -37,10 +42,106 @@ _Static_assert(NUM_STATUS_BITS == 16u,
                "NUM_STATUS_BITS must equal the width of the bank storage type "
                "(uint16_t)");
 
+/* Number of status classes (fault, warning, info). */
+#define NUM_STATUS_CLASSES (3u)
+
+/* Number of addressable IDs per class; dense index is bank * 16 + bit. */
+#define NUM_STATUS_IDS (NUM_STATUS_BANKS * NUM_STATUS_BITS)
+
+/* Features that need the time of each ID's most recent set edge. */
+#define STATUS_TRACK_SET_TIME                                                  \
+        (STATUS_ENABLE_TIME_IN_STATE || STATUS_ENABLE_HISTOGRAM)
+
+#if STATUS_TRACK_SET_TIME && !defined(STATUS_TIME_NOW)
+#error "STATUS_ENABLE_TIME_IN_STATE / STATUS_ENABLE_HISTOGRAM require STATUS_TIME_NOW()"
+#endif
+
+#if STATUS_ENABLE_HISTOGRAM
+_Static_assert((STATUS_HIST_SLOTS > 0u) && (STATUS_HIST_SLOTS < 255u),
+               "STATUS_HIST_SLOTS must be in 1..254");
+_Static_assert((STATUS_HIST_BUCKETS > 0u) && (STATUS_HIST_BUCKETS <= 32u),
+               "STATUS_HIST_BUCKETS must be in 1..32");
+#endif
+
+#if STATUS_ENABLE_PRIORITY
+_Static_assert((STATUS_PRIO_LEVELS >= 32u) && (STATUS_PRIO_LEVELS <= 1024u)
+                   && ((STATUS_PRIO_LEVELS % 32u) == 0u),
+               "STATUS_PRIO_LEVELS must be a multiple of 32 in 32..1024");
+
+/* Level-1 words of the priority bitmap; one summary bit per word. */
+#define PRIO_WORDS (STATUS_PRIO_LEVELS / 32u)
+#endif
+
+#if STATUS_ENABLE_META
+_Static_assert(STATUS_META_LEN == NUM_STATUS_IDS,
+               "STATUS_META_LEN must cover every ID of a class");
+#endif
+
+/*
+ * The error path is lock-free where the toolchain provides lock-free C11
+ * atomics for pointers and 32-bit counters; otherwise it falls back to the
+ * critical section.
+ */
+#if !defined(__STDC_NO_ATOMICS__) && (ATOMIC_POINTER_LOCK_FREE == 2)          \
+    && (ATOMIC_INT_LOCK_FREE == 2) && (ATOMIC_LONG_LOCK_FREE == 2)
+#define STATUS_ERR_ATOMIC (1)
+#else
+#define STATUS_ERR_ATOMIC (0)
+#endif
+
+#if STATUS_ENABLE_INTEGRITY
+/* Odd weight of a bank in the integrity sum. */
+#define CHK_WEIGHT(bank) ((2u * (uint32_t)(bank)) + 1u)
+#endif
+
+#if STATUS_ENABLE_SHADOW
+/* Banks visited by one full scrub cycle. */
+#define SCRUB_SPAN ((size_t)NUM_STATUS_CLASSES * NUM_STATUS_BANKS)
+#endif
+
+#if STATUS_ENABLE_SOURCES
+_Static_assert((STATUS_SOURCES_MAX >= 1u) && (STATUS_SOURCES_MAX <= 32u),
+               "STATUS_SOURCES_MAX must be in 1..32");
+#endif
+
+#if STATUS_ENABLE_BANK_ALLOC
+_Static_assert(STATUS_BANK_ALLOC_FIRST <= NUM_STATUS_BANKS,
+               "STATUS_BANK_ALLOC_FIRST must be <= NUM_STATUS_BANKS");
+
+/* Words of the free-bank bitmap; bit b%32 of word b/32 set = bank b free. */
+#define ALLOC_WORDS ((NUM_STATUS_BANKS + 31u) / 32u)
+#endif
+
+_Static_assert(!STATUS_ENABLE_BANK_OWNERS || STATUS_ENABLE_BANK_ALLOC,
+               "STATUS_ENABLE_BANK_OWNERS requires STATUS_ENABLE_BANK_ALLOC");
+
+#if STATUS_ENABLE_DIRTY
+/* Words of each class's dirty bitmap; bit b%32 of word b/32 = bank b. */
+#define DIRTY_WORDS ((NUM_STATUS_BANKS + 31u) / 32u)
+#endif
+
 /* ================ STRUCTURES ============================================== */
 
+/* What status_query_*() evaluates over the query's banks. */
+enum query_mode {
+        QUERY_ANY = 0,
+        QUERY_ALL,
+        QUERY_COLLECT,
+};
+
 /* ================ TYPEDEFS ================================================ */
 
+#if STATUS_ENABLE_SOURCES
+/* Narrowest word holding one bit per source. */
+#if STATUS_SOURCES_MAX <= 8u
+typedef uint8_t source_mask_t;
+#elif STATUS_SOURCES_MAX <= 16u
+typedef uint16_t source_mask_t;
+#else
+typedef uint32_t source_mask_t;
+#endif
+#endif
+
 /* ================ STATIC PROTOTYPES ======================================= */
 
 /* ================ STATIC VARIABLES ======================================== */
@@ -53,7 +154,95 @@ static volatile uint16_t last_fault_id = STATUS_UNSET_ID;
 static volatile uint16_t last_warning_id = STATUS_UNSET_ID;
 static volatile uint16_t last_info_id = STATUS_UNSET_ID;
 
+#if STATUS_ERR_ATOMIC
+static _Atomic(status_err_cb_t) err_cb = NULL;
+/* Per-error saturating count and first / last offending ID. */
+static _Atomic uint32_t err_count[STATUS_ERR_NUM];
+static _Atomic uint32_t err_first[STATUS_ERR_NUM];
+static _Atomic uint32_t err_last[STATUS_ERR_NUM];
+/* Callback every Nth occurrence of an error; 0 and 1 mean every one. */
+static _Atomic uint32_t err_every = 1u;
+#else
 static volatile status_err_cb_t err_cb = NULL;
+static uint32_t err_count[STATUS_ERR_NUM];
+static uint32_t err_first[STATUS_ERR_NUM];
+static uint32_t err_last[STATUS_ERR_NUM];
+static uint32_t err_every = 1u;
+#endif
+
+#if STATUS_TRACK_SET_TIME
+/* Time of the most recent set edge, per ID. */
+static status_time_t set_time[NUM_STATUS_CLASSES][NUM_STATUS_IDS];
+#endif
+
+#if STATUS_ENABLE_TIME_IN_STATE
+/* Active time of all completed set..clear intervals, per ID. */
+static status_time_t tis_total[NUM_STATUS_CLASSES][NUM_STATUS_IDS];
+#endif
+
+#if STATUS_ENABLE_HISTOGRAM
+/* Histogram slot bound to each ID, stored as slot + 1 (0 = unbound). */
+static uint8_t hist_bind[NUM_STATUS_CLASSES][NUM_STATUS_IDS];
+static uint32_t hist_counts[STATUS_HIST_SLOTS][STATUS_HIST_BUCKETS];
+#endif
+
+#if STATUS_ENABLE_PRIORITY
+/* Rank assigned to each ID, stored as rank + 1 (0 = untracked). */
+static uint16_t prio_rank[NUM_STATUS_CLASSES][NUM_STATUS_IDS];
+/* ID holding each rank, stored as ID + 1 (0 = free). */
+static uint16_t prio_id[NUM_STATUS_CLASSES][STATUS_PRIO_LEVELS];
+/* Two-level bitmap of active ranks: bit r%32 of word r/32. */
+static uint32_t prio_words[NUM_STATUS_CLASSES][PRIO_WORDS];
+static uint32_t prio_summary[NUM_STATUS_CLASSES];
+#endif
+
+#if STATUS_ENABLE_META
+/* Consecutive set requests seen per ID, for metadata-driven debounce. */
+static uint8_t debounce_count[NUM_STATUS_CLASSES][NUM_STATUS_IDS];
+#endif
+
+#if STATUS_ENABLE_INTEGRITY
+/* sum(bank[i] * CHK_WEIGHT(i)) mod 2^32, and an independently kept ~sum. */
+static uint32_t chk_sum[NUM_STATUS_CLASSES];
+static uint32_t chk_inv[NUM_STATUS_CLASSES];
+/* Background pass: banks [0, chk_cursor) are summed into chk_partial. */
+static uint32_t chk_partial[NUM_STATUS_CLASSES];
+static uint16_t chk_cursor[NUM_STATUS_CLASSES];
+#endif
+
+#if STATUS_ENABLE_SHADOW
+/* Complement of every bank, kept in step with the primaries. */
+static volatile uint16_t shadow_banks[NUM_STATUS_CLASSES][NUM_STATUS_BANKS];
+/* Next bank to scrub, as cls * NUM_STATUS_BANKS + bank. */
+static size_t scrub_cursor;
+/* Mismatches repaired by writes, reported by the next status_scrub_step(). */
+static size_t shadow_fixed;
+static uint16_t shadow_fixed_id;
+#endif
+
+#if STATUS_ENABLE_SOURCES
+/* Sources asserting each ID; dropped whenever the ID is cleared. */
+static source_mask_t source_masks[NUM_STATUS_CLASSES][NUM_STATUS_IDS];
+#endif
+
+#if STATUS_ENABLE_BANK_ALLOC
+static uint32_t bank_free_map[ALLOC_WORDS];
+#endif
+
+#if STATUS_ENABLE_BANK_OWNERS
+/* Owner token of every bank; STATUS_OWNER_NONE when not allocated. */
+static uint8_t bank_owner[NUM_STATUS_BANKS];
+#endif
+
+#if STATUS_ENABLE_DIRTY
+/* Banks changed since status_dirty_next() last handed them out. */
+static uint32_t dirty_map[NUM_STATUS_CLASSES][DIRTY_WORDS];
+#endif
+
+#if STATUS_ENABLE_EDGE_HOOK
+static status_edge_cb_t edge_cb;
+static void *edge_ctx;
+#endif
 
 /* ================ MACROS ================================================== */
 
@@ -65,6 +254,12 @@ size_min(size_t a, size_t b)
         return (a < b) ? a : b;
 }
 
+static inline status_time_t
+time_add_sat(status_time_t a, status_time_t b)
+{
+        return (a > (UINT32_MAX - b)) ? UINT32_MAX : (status_time_t)(a + b);
+}
+
 /* Writeable view */
 static inline volatile uint16_t *
 get_banks_mut(enum status_class cls)
@@ -88,26 +283,385 @@ get_banks_ro(enum status_class cls)
         return get_banks_mut(cls); /* adds const qualifier */
 }
 
+/*
+ * Record an error and decide whether the callback should see it.
+ *
+ * The counter update is the whole cost of a suppressed error. The callback
+ * runs outside any critical section so that a handler re-entering the
+ * status API (e.g. to set a secondary fault) does not deadlock.
+ */
 static void
 invoke_err_cb(status_err_t err, uint16_t id)
 {
-        /*
-         * Snapshot the callback pointer under the critical section to avoid a
-         * data race with status_set_err_callback() on architectures or RTOS
-         * environments where pointer reads are not naturally atomic.  The
-         * actual invocation happens outside the critical section so that a
-         * callback that re-enters the status API (e.g. to set a secondary
-         * fault) does not deadlock.
-         */
+        const size_t e = (size_t)err;
+        bool notify = false;
+        status_err_cb_t cb = NULL;
+
+        if (e >= STATUS_ERR_NUM) {
+                return;
+        }
+
+#if STATUS_ERR_ATOMIC
+        uint32_t prev = atomic_load_explicit(&err_count[e],
+                                             memory_order_relaxed);
+        const uint32_t every = atomic_load_explicit(&err_every,
+                                                    memory_order_relaxed);
+
+        while ((prev != UINT32_MAX)
+               && !atomic_compare_exchange_weak_explicit(
+                   &err_count[e], &prev, prev + 1u, memory_order_relaxed,
+                   memory_order_relaxed)) {
+        }
+        if (prev == 0u) {
+                atomic_store_explicit(&err_first[e], id, memory_order_relaxed);
+        }
+        atomic_store_explicit(&err_last[e], id, memory_order_relaxed);
+        notify = (every <= 1u)
+                 || ((prev != UINT32_MAX) && ((prev % every) == 0u));
+        if (notify) {
+                cb = atomic_load_explicit(&err_cb, memory_order_acquire);
+        }
+#else
         STATUS_ENTER_CRITICAL();
-        status_err_cb_t cb = err_cb;
+        const uint32_t prev = err_count[e];
+
+        if (prev != UINT32_MAX) {
+                err_count[e] = prev + 1u;
+        }
+        if (prev == 0u) {
+                err_first[e] = id;
+        }
+        err_last[e] = id;
+        notify = (err_every <= 1u)
+                 || ((prev != UINT32_MAX) && ((prev % err_every) == 0u));
+        cb = err_cb;
         STATUS_EXIT_CRITICAL();
+#endif
 
-        if (cb != NULL) {
+        if (notify && (cb != NULL)) {
                 cb(err, id);
         }
 }
 
+static void
+err_stats_reset(void)
+{
+        for (size_t e = 0u; e < STATUS_ERR_NUM; ++e) {
+#if STATUS_ERR_ATOMIC
+                atomic_store_explicit(&err_count[e], 0u, memory_order_relaxed);
+                atomic_store_explicit(&err_first[e], STATUS_UNSET_ID,
+                                      memory_order_relaxed);
+                atomic_store_explicit(&err_last[e], STATUS_UNSET_ID,
+                                      memory_order_relaxed);
+#else
+                err_count[e] = 0u;
+                err_first[e] = STATUS_UNSET_ID;
+                err_last[e] = STATUS_UNSET_ID;
+#endif
+        }
+}
+
+#if STATUS_ENABLE_HISTOGRAM
+/* Log2 bucket of a duration: 0..1 -> 0, 2..3 -> 1, 4..7 -> 2, ... */
+static inline size_t
+hist_bucket(status_time_t d)
+{
+        const size_t k = (d != 0u) ? bit_msb32(d) : 0u;
+
+        return (k < STATUS_HIST_BUCKETS) ? k : (STATUS_HIST_BUCKETS - 1u);
+}
+#endif
+
+#if STATUS_TRACK_SET_TIME
+static void
+edge_time_update(enum status_class cls, uint16_t bank, uint16_t old_val,
+                 uint16_t new_val)
+{
+        uint16_t edges = (uint16_t)(old_val ^ new_val);
+
+        if (edges != 0u) {
+                const status_time_t now = STATUS_TIME_NOW();
+                const size_t base = (size_t)bank * NUM_STATUS_BITS;
+
+                while (edges != 0u) {
+                        const unsigned int bit = bit_ctz16(edges);
+                        const size_t i = base + bit;
+
+                        if ((new_val & (uint16_t)((uint32_t)1u << bit)) != 0u) {
+                                set_time[cls][i] = now;
+                        } else {
+                                const status_time_t d = now - set_time[cls][i];
+#if STATUS_ENABLE_TIME_IN_STATE
+                                tis_total[cls][i] =
+                                    time_add_sat(tis_total[cls][i], d);
+#endif
+#if STATUS_ENABLE_HISTOGRAM
+                                const uint8_t slot = hist_bind[cls][i];
+
+                                if (slot != 0u) {
+                                        uint32_t *c =
+                                            &hist_counts[slot - 1u]
+                                                        [hist_bucket(d)];
+
+                                        if (*c != UINT32_MAX) {
+                                                ++*c;
+                                        }
+                                }
+#endif
+                        }
+                        edges = (uint16_t)(edges & (uint16_t)(edges - 1u));
+                }
+        }
+}
+#endif
+
+#if STATUS_ENABLE_PRIORITY
+static inline void
+prio_mark(enum status_class cls, uint16_t rank, bool active)
+{
+        const size_t w = rank / 32u;
+        const uint32_t m = (uint32_t)1u << (rank % 32u);
+
+        if (active) {
+                prio_words[cls][w] |= m;
+                prio_summary[cls] |= (uint32_t)1u << w;
+        } else {
+                prio_words[cls][w] &= ~m;
+                if (prio_words[cls][w] == 0u) {
+                        prio_summary[cls] &= ~((uint32_t)1u << w);
+                }
+        }
+}
+
+static void
+prio_update(enum status_class cls, uint16_t bank, uint16_t old_val,
+            uint16_t new_val)
+{
+        uint16_t edges = (uint16_t)(old_val ^ new_val);
+        const size_t base = (size_t)bank * NUM_STATUS_BITS;
+
+        while (edges != 0u) {
+                const unsigned int bit = bit_ctz16(edges);
+                const uint16_t r = prio_rank[cls][base + bit];
+
+                if (r != 0u) {
+                        prio_mark(cls, (uint16_t)(r - 1u),
+                                  (new_val & (uint16_t)((uint32_t)1u << bit))
+                                      != 0u);
+                }
+                edges = (uint16_t)(edges & (uint16_t)(edges - 1u));
+        }
+}
+#endif
+
+#if STATUS_ENABLE_META && STATUS_ENABLE_PRIORITY
+/*
+ * Rebuild the rank tables from the metadata table. Called from status_init()
+ * inside its critical section; returns the first ID whose rank was rejected
+ * (out of range or already taken), or STATUS_UNSET_ID.
+ */
+static uint16_t
+prio_load_meta(void)
+{
+        uint16_t rejected = STATUS_UNSET_ID;
+
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                for (size_t r = 0u; r < STATUS_PRIO_LEVELS; ++r) {
+                        prio_id[c][r] = 0u;
+                }
+                for (size_t i = 0u; i < NUM_STATUS_IDS; ++i) {
+                        const uint16_t p = status_meta_table[c][i].prio;
+
+                        prio_rank[c][i] = 0u;
+                        if (p == 0u) {
+                                continue; /* unranked */
+                        }
+                        if ((p <= STATUS_PRIO_LEVELS)
+                            && (prio_id[c][p - 1u] == 0u)) {
+                                prio_rank[c][i] = p;
+                                prio_id[c][p - 1u] = (uint16_t)(i + 1u);
+                        } else if (rejected == STATUS_UNSET_ID) {
+                                rejected = (uint16_t)i;
+                        }
+                }
+        }
+
+        return rejected;
+}
+#endif
+
+/*
+ * Metadata-driven set/clear filters, evaluated inside the critical section.
+ * A set request only reaches the register once the ID's debounce count is
+ * met; a clear request is ignored for latched IDs (see status_ack()).
+ */
+static inline bool
+meta_allow_set(enum status_class cls, uint16_t id)
+{
+        bool allow = true;
+
+#if STATUS_ENABLE_META
+        const uint8_t need = status_meta_table[cls][id].debounce;
+        uint8_t *count = &debounce_count[cls][id];
+
+        if (*count < need) {
+                ++*count;
+        }
+        allow = (*count >= need);
+#else
+        (void)cls;
+        (void)id;
+#endif
+        return allow;
+}
+
+static inline bool
+meta_allow_clear(enum status_class cls, uint16_t id, bool force)
+{
+        bool allow = true;
+
+#if STATUS_ENABLE_META
+        debounce_count[cls][id] = 0u;
+        allow = force
+                || ((status_meta_table[cls][id].flags & STATUS_META_LATCH)
+                    == 0u);
+#else
+        (void)cls;
+        (void)id;
+        (void)force;
+#endif
+        return allow;
+}
+
+/*
+ * Every bank write funnels through here, inside the caller's critical
+ * section, with the previous and new value of the bank. Optional features
+ * that react to set/clear edges hook in below.
+ *
+ * With the shadow, the previous value is taken from it: the hooks last saw
+ * the value written then, not a primary an upset has altered since. A bit
+ * a repair restores is then no edge, and the checksum keeps matching.
+ */
+static inline void
+on_bank_change(enum status_class cls, uint16_t bank, uint16_t old_val,
+               uint16_t new_val)
+{
+#if STATUS_ENABLE_SHADOW
+        old_val = (uint16_t)~shadow_banks[cls][bank];
+#endif
+#if STATUS_TRACK_SET_TIME
+        edge_time_update(cls, bank, old_val, new_val);
+#endif
+#if STATUS_ENABLE_PRIORITY
+        prio_update(cls, bank, old_val, new_val);
+#endif
+#if STATUS_ENABLE_INTEGRITY
+        const uint32_t d =
+            ((uint32_t)new_val - (uint32_t)old_val) * CHK_WEIGHT(bank);
+
+        chk_sum[cls] += d;
+        chk_inv[cls] -= d;
+        if (bank < chk_cursor[cls]) {
+                chk_partial[cls] += d;
+        }
+#endif
+#if STATUS_ENABLE_SHADOW
+        shadow_banks[cls][bank] = (uint16_t)~new_val;
+#endif
+#if STATUS_ENABLE_SOURCES
+        /* A cleared ID has no sources left, however it was cleared. */
+        for (uint16_t fell = (uint16_t)(old_val & (uint16_t)~new_val);
+             fell != 0u; fell &= (uint16_t)(fell - 1u)) {
+                source_masks[cls][STATUS_ENCODE(bank, bit_ctz16(fell))] = 0u;
+        }
+#endif
+#if STATUS_ENABLE_DIRTY
+        if (new_val != old_val) {
+                dirty_map[cls][bank / 32u] |= (uint32_t)1u << (bank % 32u);
+        }
+#endif
+#if STATUS_ENABLE_EDGE_HOOK
+        if ((edge_cb != NULL) && (new_val != old_val)) {
+                edge_cb(cls, bank, old_val, new_val, edge_ctx);
+        }
+#endif
+        (void)cls;
+        (void)bank;
+        (void)old_val;
+        (void)new_val;
+}
+
+/*
+ * Value a write to `bank` builds on. With the shadow, a pair that disagrees
+ * is first repaired to primary | ~shadow as the scrubber would; otherwise
+ * the write would copy a corrupted primary into the shadow and the damage
+ * could no longer be seen. The repair is left for status_scrub_step() to
+ * report, since the error callback cannot run in the critical section.
+ */
+static inline uint16_t
+write_base_locked(enum status_class cls, uint16_t bank, uint16_t val)
+{
+#if STATUS_ENABLE_SHADOW
+        const uint16_t ref = (uint16_t)~shadow_banks[cls][bank];
+        const uint16_t diff = (uint16_t)(val ^ ref);
+
+        if (diff != 0u) {
+                if (shadow_fixed == 0u) {
+                        shadow_fixed_id = STATUS_ENCODE(bank, bit_ctz16(diff));
+                }
+                ++shadow_fixed;
+                val = (uint16_t)(val | ref);
+        }
+#else
+        (void)cls;
+        (void)bank;
+#endif
+        return val;
+}
+
+/*
+ * Locked cores of set/clear: the caller holds the exclusive critical section
+ * and has validated the class and bank. The set reports whether debounce
+ * let it through.
+ */
+static bool
+set_bit_locked(volatile uint16_t *b, enum status_class cls, uint16_t id)
+{
+        const uint16_t bank = status_bank(id);
+        const uint16_t bit = status_bit(id);
+        const bool allow = meta_allow_set(cls, id);
+
+        if (allow) {
+                const uint16_t old_val = b[bank];
+                const uint16_t new_val = (uint16_t)(write_base_locked(cls, bank, old_val) | (uint16_t)((uint32_t)1u << (uint32_t)bit));
+                b[bank] = new_val;
+                on_bank_change(cls, bank, old_val, new_val);
+                switch (cls) {
+                case STATUS_CLASS_FAULT: last_fault_id = id; break;
+                case STATUS_CLASS_WARNING: last_warning_id = id; break;
+                case STATUS_CLASS_INFO: last_info_id = id; break;
+                default: break;
+                }
+        }
+
+        return allow;
+}
+
+static void
+clear_bit_locked(volatile uint16_t *b, enum status_class cls, uint16_t id,
+                 bool force)
+{
+        const uint16_t bank = status_bank(id);
+        const uint16_t bit = status_bit(id);
+
+        if (meta_allow_clear(cls, id, force)) {
+                const uint16_t old_val = b[bank];
+                const uint16_t new_val = (uint16_t)(write_base_locked(cls, bank, old_val) & (uint16_t)(0xFFFFu ^ (uint16_t)((uint32_t)1u << (uint32_t)bit)));
+                b[bank] = new_val;
+                on_bank_change(cls, bank, old_val, new_val);
+        }
+}
+
 static void
 set_bit(uint16_t id, enum status_class cls)
 {
@@ -119,22 +673,14 @@ set_bit(uint16_t id, enum status_class cls)
         } else if (b == NULL) {
                 invoke_err_cb(STATUS_ERR_INVALID_ID, id);
         } else {
-                uint16_t bit = status_bit(id);
-
                 STATUS_ENTER_CRITICAL();
-                b[bank] = (uint16_t)(b[bank] | (uint16_t)((uint32_t)1u << (uint32_t)bit));
-                switch (cls) {
-                case STATUS_CLASS_FAULT: last_fault_id = id; break;
-                case STATUS_CLASS_WARNING: last_warning_id = id; break;
-                case STATUS_CLASS_INFO: last_info_id = id; break;
-                default: break;
-                }
+                set_bit_locked(b, cls, id);
                 STATUS_EXIT_CRITICAL();
         }
 }
 
 static void
-clear_bit(uint16_t id, enum status_class cls)
+clear_bit(uint16_t id, enum status_class cls, bool force)
 {
         uint16_t bank = status_bank(id);
         volatile uint16_t *b = get_banks_mut(cls);
@@ -144,10 +690,8 @@ clear_bit(uint16_t id, enum status_class cls)
         } else if (b == NULL) {
                 invoke_err_cb(STATUS_ERR_INVALID_ID, id);
         } else {
-                uint16_t bit = status_bit(id);
-
                 STATUS_ENTER_CRITICAL();
-                b[bank] = (uint16_t)(b[bank] & (uint16_t)(0xFFFFu ^ (uint16_t)((uint32_t)1u << (uint32_t)bit)));
+                clear_bit_locked(b, cls, id, force);
                 STATUS_EXIT_CRITICAL();
         }
 }
@@ -166,176 +710,1284 @@ is_bit_set(uint16_t id, enum status_class cls)
         } else {
                 uint16_t bit = status_bit(id);
 
-                STATUS_ENTER_CRITICAL();
+                STATUS_ENTER_READ();
                 result =
                     (b[bank] & (uint16_t)((uint32_t)1u << (uint32_t)bit)) != 0u;
-                STATUS_EXIT_CRITICAL();
+                STATUS_EXIT_READ();
         }
 
         return result;
 }
 
-/* ================ GLOBAL FUNCTIONS ======================================== */
-
-void
-status_init(void)
-{
-        STATUS_ENTER_CRITICAL();
-        for (size_t i = 0u; i < NUM_STATUS_BANKS; ++i) {
-                fault_banks[i] = 0u;
-                warning_banks[i] = 0u;
-                info_banks[i] = 0u;
-        }
-        last_fault_id = STATUS_UNSET_ID;
-        last_warning_id = STATUS_UNSET_ID;
-        last_info_id = STATUS_UNSET_ID;
-        STATUS_EXIT_CRITICAL();
-}
-
-void
-status_set_err_callback(status_err_cb_t cb)
-{
-        STATUS_ENTER_CRITICAL();
-        err_cb = cb;
-        STATUS_EXIT_CRITICAL();
-}
-
-void
-status_set_warning(uint16_t id)
-{
-        set_bit(id, STATUS_CLASS_WARNING);
-}
-
-void
-status_set_fault(uint16_t id)
-{
-        set_bit(id, STATUS_CLASS_FAULT);
-}
-
-void
-status_set_info(uint16_t id)
-{
-        set_bit(id, STATUS_CLASS_INFO);
-}
-
-void
-status_clear_warning(uint16_t id)
+/*
+ * Evaluate a query over `b`; the caller holds a read or exclusive section.
+ * Each bank is read once, with early exit for any/all. Returns 1/0 for the
+ * predicates and the number of active IDs for QUERY_COLLECT. A term outside
+ * the register sets *bad_bank and yields 0.
+ */
+static size_t
+query_eval_locked(const volatile uint16_t *b,
+                  const struct status_query_term *terms, size_t n,
+                  enum query_mode mode, uint16_t *dst, bool *bad_bank)
 {
-        clear_bit(id, STATUS_CLASS_WARNING);
-}
+        size_t result = (mode == QUERY_ALL) ? 1u : 0u;
 
-void
-status_clear_fault(uint16_t id)
-{
-        clear_bit(id, STATUS_CLASS_FAULT);
-}
+        for (size_t i = 0u; i < n; ++i) {
+                const uint16_t mask = terms[i].mask;
 
-void
-status_clear_info(uint16_t id)
-{
-        clear_bit(id, STATUS_CLASS_INFO);
-}
+                if (terms[i].bank >= NUM_STATUS_BANKS) {
+                        *bad_bank = true;
+                        return 0u;
+                }
 
-bool
-status_is_warning_set(uint16_t id)
-{
-        return is_bit_set(id, STATUS_CLASS_WARNING);
-}
+                const uint16_t hit = (uint16_t)(b[terms[i].bank] & mask);
 
-bool
-status_is_fault_set(uint16_t id)
-{
-        return is_bit_set(id, STATUS_CLASS_FAULT);
-}
+                if (mode == QUERY_ANY) {
+                        if (hit != 0u) {
+                                return 1u;
+                        }
+                } else if (mode == QUERY_ALL) {
+                        if (hit != mask) {
+                                return 0u;
+                        }
+                } else {
+                        dst[i] = hit;
+                        result += bit_popcount16(hit);
+                }
+        }
 
-bool
-status_is_info_set(uint16_t id)
-{
-        return is_bit_set(id, STATUS_CLASS_INFO);
+        return result;
 }
 
-bool
-status_any(enum status_class cls)
+/* Shared body of status_query_any/all/collect(): one read section. */
+static size_t
+query_run(enum status_class cls, const struct status_query_term *terms,
+          size_t n, enum query_mode mode, uint16_t *dst)
 {
         const volatile uint16_t *b = get_banks_ro(cls);
-        bool result = false;
+        size_t result;
+        bool bad_bank = false;
 
         if (b == NULL) {
                 invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
-        } else {
-                STATUS_ENTER_CRITICAL();
-                for (size_t i = 0u; (i < NUM_STATUS_BANKS) && !result; ++i) {
-                        if (b[i] != 0u) {
-                                result = true;
-                        }
-                }
-                STATUS_EXIT_CRITICAL();
+                return 0u;
+        }
+        if ((terms == NULL) || ((mode == QUERY_COLLECT) && (dst == NULL))) {
+                invoke_err_cb(STATUS_ERR_NULL_PTR, STATUS_UNSET_ID);
+                return 0u;
+        }
+
+        STATUS_ENTER_READ();
+        result = query_eval_locked(b, terms, n, mode, dst, &bad_bank);
+        STATUS_EXIT_READ();
+
+        if (bad_bank) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, STATUS_UNSET_ID);
         }
 
         return result;
 }
 
-void
-status_clear_all(enum status_class cls)
+/*
+ * Shared body of status_set_if() / status_clear_unless(): evaluate the
+ * condition and apply the update under one exclusive section, so no writer
+ * can slip in between the two. The update is applied when the condition's
+ * value equals `when`; returns whether it was.
+ */
+static bool
+cond_update(enum status_class cls, uint16_t id,
+            const struct status_cond *cond, bool when, bool set)
+{
+        volatile uint16_t *b = get_banks_mut(cls);
+        const volatile uint16_t *cb =
+            (cond != NULL) ? get_banks_ro(cond->cls) : NULL;
+        bool applied = false;
+        bool bad_bank = false;
+
+        if (status_bank(id) >= NUM_STATUS_BANKS) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, id);
+                return false;
+        }
+        if (b == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, id);
+                return false;
+        }
+        if ((cond == NULL) || ((cond->terms == NULL) && (cond->n != 0u))) {
+                invoke_err_cb(STATUS_ERR_NULL_PTR, id);
+                return false;
+        }
+        if ((cb == NULL) || (cond->op > STATUS_COND_NONE)) {
+                invoke_err_cb(STATUS_ERR_INVALID_ARG, id);
+                return false;
+        }
+
+        STATUS_ENTER_CRITICAL();
+        const enum query_mode mode =
+            (cond->op == STATUS_COND_ALL) ? QUERY_ALL : QUERY_ANY;
+        const bool r = query_eval_locked(cb, cond->terms, cond->n, mode, NULL,
+                                         &bad_bank)
+                       != 0u;
+
+        const bool holds = (cond->op == STATUS_COND_NONE) ? !r : r;
+
+        if (!bad_bank && (holds == when)) {
+                applied = true;
+                if (set) {
+                        set_bit_locked(b, cls, id);
+                } else {
+                        clear_bit_locked(b, cls, id, false);
+                }
+        }
+        STATUS_EXIT_CRITICAL();
+
+        if (bad_bank) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, id);
+        }
+
+        return applied;
+}
+
+#if STATUS_ENABLE_SOURCES
+/* Shared body of status_source_set() / status_source_clear(). */
+static void
+source_update(enum status_class cls, uint16_t id, uint8_t src, bool set)
 {
         volatile uint16_t *b = get_banks_mut(cls);
 
+        if (status_bank(id) >= NUM_STATUS_BANKS) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, id);
+        } else if (b == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, id);
+        } else if (src >= STATUS_SOURCES_MAX) {
+                invoke_err_cb(STATUS_ERR_INVALID_ARG, id);
+        } else {
+                const source_mask_t bit = (source_mask_t)((uint32_t)1u << src);
+
+                STATUS_ENTER_CRITICAL();
+                source_mask_t *m = &source_masks[cls][id];
+
+                if (set) {
+                        /* A set held back by debounce asserts no source. */
+                        if (set_bit_locked(b, cls, id)) {
+                                *m = (source_mask_t)(*m | bit);
+                        }
+                } else if ((*m & bit) != 0u) {
+                        *m = (source_mask_t)(*m & (source_mask_t)~bit);
+                        if (*m == 0u) {
+                                clear_bit_locked(b, cls, id, false);
+                        }
+                } else {
+                        /* Not asserted by this source: nothing to release. */
+                }
+                STATUS_EXIT_CRITICAL();
+        }
+}
+#endif
+
+/* Validate a field for status_field_set/get(), reporting any error. */
+static bool
+field_valid(enum status_class cls, status_field_t f)
+{
+        const uint16_t bank = status_field_bank(f);
+        const uint16_t shift = status_field_shift(f);
+        const uint16_t id = STATUS_ENCODE(bank, shift);
+        bool ok = false;
+
+        if (bank >= NUM_STATUS_BANKS) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, id);
+        } else if (get_banks_ro(cls) == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, id);
+        } else if ((shift + status_field_width(f)) > NUM_STATUS_BITS) {
+                invoke_err_cb(STATUS_ERR_INVALID_ARG, id);
+        } else {
+                ok = true;
+        }
+
+        return ok;
+}
+
+/* Value mask of a field, before shifting into place. */
+static inline uint16_t
+field_max(uint16_t width)
+{
+        return (uint16_t)(((uint32_t)1u << width) - 1u);
+}
+
+/*
+ * Top bit of every `width`-bit lane of `x` whose value is >= `level`
+ * (1 <= level <= field_max(width)). Adding 2^width - level to a lane carries
+ * out of it exactly when the lane is >= level. The carry out of a lane is
+ * the majority of its two top bits and the carry into them, and the carry
+ * into them comes from adding the lower bits with the top bits masked off,
+ * so no carry crosses into the next lane.
+ */
+static inline uint16_t
+field_ge_lanes(uint16_t x, uint16_t width, uint16_t level)
+{
+        const uint32_t ones = 0xFFFFu / (uint32_t)field_max(width);
+        const uint16_t high = (uint16_t)(ones << (width - 1u));
+        const uint16_t low = (uint16_t)~high;
+        const uint16_t k = (uint16_t)(ones * (((uint32_t)1u << width) - level));
+        const uint16_t sum =
+            (uint16_t)((uint32_t)(x & low) + (uint32_t)(k & low));
+
+        return (uint16_t)(((x & k) | ((x ^ k) & sum)) & high);
+}
+
+/* Shared body of status_field_count/any_at_least(). */
+static size_t
+field_scan(enum status_class cls, uint16_t bank, uint16_t n_banks,
+           uint16_t width, uint16_t level, bool first_only)
+{
+        const volatile uint16_t *b = get_banks_ro(cls);
+        size_t count = 0u;
+
+        if (((uint32_t)bank + n_banks) > NUM_STATUS_BANKS) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, STATUS_UNSET_ID);
+                return 0u;
+        }
         if (b == NULL) {
                 invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
+                return 0u;
+        }
+        if ((width == 0u) || (width > NUM_STATUS_BITS)
+            || ((width & (width - 1u)) != 0u)) {
+                invoke_err_cb(STATUS_ERR_INVALID_ARG, STATUS_UNSET_ID);
+                return 0u;
+        }
+        if (level > field_max(width)) {
+                return 0u;
+        }
+        if (level == 0u) {
+                return (size_t)n_banks * (NUM_STATUS_BITS / width);
+        }
+
+        STATUS_ENTER_READ();
+        for (uint16_t i = 0u; i < n_banks; ++i) {
+                const uint16_t ge = field_ge_lanes(b[bank + i], width, level);
+
+                count += bit_popcount16(ge);
+                if (first_only && (count != 0u)) {
+                        break;
+                }
+        }
+        STATUS_EXIT_READ();
+
+        return count;
+}
+
+#if STATUS_ENABLE_BANK_ALLOC
+/* Mark banks [first, first + n) free or allocated, a word at a time. */
+static void
+alloc_mark(size_t first, size_t n, bool mark_free)
+{
+        const size_t end = first + n;
+
+        for (size_t i = first; i < end;) {
+                const size_t lo = i % 32u;
+                const size_t cnt = size_min(32u - lo, end - i);
+                const uint32_t m = (cnt == 32u)
+                                       ? UINT32_MAX
+                                       : ((((uint32_t)1u << cnt) - 1u) << lo);
+
+                if (mark_free) {
+                        bank_free_map[i / 32u] |= m;
+                } else {
+                        bank_free_map[i / 32u] &= ~m;
+                }
+                i += cnt;
+        }
+}
+
+/* First bank >= pos that is free (or, with !want_free, allocated). */
+static size_t
+alloc_next(size_t pos, bool want_free)
+{
+        while (pos < NUM_STATUS_BANKS) {
+                const size_t w = pos / 32u;
+                uint32_t bits =
+                    want_free ? bank_free_map[w] : ~bank_free_map[w];
+
+                bits &= UINT32_MAX << (pos % 32u);
+                if (bits != 0u) {
+                        return size_min((w * 32u) + bit_ctz32(bits),
+                                        NUM_STATUS_BANKS);
+                }
+                pos = (w + 1u) * 32u;
+        }
+
+        return NUM_STATUS_BANKS;
+}
+#endif
+
+#if STATUS_ENABLE_BANK_OWNERS
+/* Shared body of status_set_owned() / status_clear_owned(). */
+static void
+owned_update(enum status_class cls, uint16_t id, uint8_t owner, bool set)
+{
+        const uint16_t bank = status_bank(id);
+        volatile uint16_t *b = get_banks_mut(cls);
+
+        if (bank >= NUM_STATUS_BANKS) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, id);
+        } else if (b == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, id);
         } else {
+                bool owned;
+
                 STATUS_ENTER_CRITICAL();
-                for (size_t i = 0u; i < NUM_STATUS_BANKS; ++i) {
-                        b[i] = 0u;
+                owned = (owner != STATUS_OWNER_NONE)
+                        && (bank_owner[bank] == owner);
+                if (owned) {
+                        if (set) {
+                                set_bit_locked(b, cls, id);
+                        } else {
+                                clear_bit_locked(b, cls, id, false);
+                        }
                 }
                 STATUS_EXIT_CRITICAL();
+
+                if (!owned) {
+                        invoke_err_cb(STATUS_ERR_NOT_OWNER, id);
+                }
         }
 }
+#endif
 
-uint16_t
-status_last_fault(void)
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+void
+status_init(void)
 {
+        uint16_t rejected = STATUS_UNSET_ID;
+
         STATUS_ENTER_CRITICAL();
-        uint16_t id = last_fault_id;
+        for (size_t i = 0u; i < NUM_STATUS_BANKS; ++i) {
+                fault_banks[i] = 0u;
+                warning_banks[i] = 0u;
+                info_banks[i] = 0u;
+        }
+        last_fault_id = STATUS_UNSET_ID;
+        last_warning_id = STATUS_UNSET_ID;
+        last_info_id = STATUS_UNSET_ID;
+#if STATUS_ENABLE_TIME_IN_STATE
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                for (size_t i = 0u; i < NUM_STATUS_IDS; ++i) {
+                        tis_total[c][i] = 0u;
+                }
+        }
+#endif
+#if STATUS_ENABLE_PRIORITY
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                for (size_t w = 0u; w < PRIO_WORDS; ++w) {
+                        prio_words[c][w] = 0u;
+                }
+                prio_summary[c] = 0u;
+        }
+#endif
+#if STATUS_ENABLE_HISTOGRAM
+        for (size_t k = 0u; k < STATUS_HIST_SLOTS; ++k) {
+                for (size_t j = 0u; j < STATUS_HIST_BUCKETS; ++j) {
+                        hist_counts[k][j] = 0u;
+                }
+        }
+#endif
+#if STATUS_ENABLE_META
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                for (size_t i = 0u; i < NUM_STATUS_IDS; ++i) {
+                        debounce_count[c][i] = 0u;
+                }
+        }
+#if STATUS_ENABLE_PRIORITY
+        rejected = prio_load_meta();
+#endif
+#endif
+#if STATUS_ENABLE_INTEGRITY
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                chk_sum[c] = 0u;
+                chk_inv[c] = ~0u;
+                chk_partial[c] = 0u;
+                chk_cursor[c] = 0u;
+        }
+#endif
+#if STATUS_ENABLE_SHADOW
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                for (size_t i = 0u; i < NUM_STATUS_BANKS; ++i) {
+                        shadow_banks[c][i] = 0xFFFFu;
+                }
+        }
+        scrub_cursor = 0u;
+        shadow_fixed = 0u;
+        shadow_fixed_id = STATUS_UNSET_ID;
+#endif
+#if STATUS_ENABLE_SOURCES
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                for (size_t i = 0u; i < NUM_STATUS_IDS; ++i) {
+                        source_masks[c][i] = 0u;
+                }
+        }
+#endif
+#if STATUS_ENABLE_BANK_ALLOC
+        for (size_t w = 0u; w < ALLOC_WORDS; ++w) {
+                bank_free_map[w] = 0u;
+        }
+        alloc_mark(STATUS_BANK_ALLOC_FIRST,
+                   NUM_STATUS_BANKS - STATUS_BANK_ALLOC_FIRST, true);
+#endif
+#if STATUS_ENABLE_BANK_OWNERS
+        for (size_t i = 0u; i < NUM_STATUS_BANKS; ++i) {
+                bank_owner[i] = STATUS_OWNER_NONE;
+        }
+#endif
+#if STATUS_ENABLE_DIRTY
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                for (size_t w = 0u; w < DIRTY_WORDS; ++w) {
+                        dirty_map[c][w] = 0u;
+                }
+        }
+#endif
         STATUS_EXIT_CRITICAL();
-        return id;
+
+        err_stats_reset();
+        if (rejected != STATUS_UNSET_ID) {
+                invoke_err_cb(STATUS_ERR_INVALID_ARG, rejected);
+        }
 }
 
-uint16_t
-status_last_warning(void)
+void
+status_set_err_callback(status_err_cb_t cb)
 {
+#if STATUS_ERR_ATOMIC
+        atomic_store_explicit(&err_cb, cb, memory_order_release);
+#else
         STATUS_ENTER_CRITICAL();
-        uint16_t id = last_warning_id;
+        err_cb = cb;
         STATUS_EXIT_CRITICAL();
-        return id;
+#endif
 }
 
-uint16_t
-status_last_info(void)
+void
+status_set_err_rate_limit(uint32_t every_n)
 {
+#if STATUS_ERR_ATOMIC
+        atomic_store_explicit(&err_every, every_n, memory_order_relaxed);
+#else
         STATUS_ENTER_CRITICAL();
-        uint16_t id = last_info_id;
+        err_every = every_n;
         STATUS_EXIT_CRITICAL();
-        return id;
+#endif
 }
 
 void
-status_snapshot(enum status_class cls, uint16_t *dst, size_t len)
+status_err_stats(struct status_err_stats *dst, size_t len)
 {
-        const volatile uint16_t *src = get_banks_ro(cls);
-
-        if (src == NULL) {
-                invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
-        } else if (dst == NULL) {
+        if (dst == NULL) {
                 invoke_err_cb(STATUS_ERR_NULL_PTR, STATUS_UNSET_ID);
         } else if (len == 0u) {
                 invoke_err_cb(STATUS_ERR_INVALID_LEN, STATUS_UNSET_ID);
         } else {
-                const size_t copy_len = size_min(len, NUM_STATUS_BANKS);
+                const size_t copy_len = size_min(len, STATUS_ERR_NUM);
 
+#if !STATUS_ERR_ATOMIC
                 STATUS_ENTER_CRITICAL();
-                for (size_t i = 0u; i < copy_len; ++i) {
-                        dst[i] = src[i];
+#endif
+                for (size_t e = 0u; e < copy_len; ++e) {
+#if STATUS_ERR_ATOMIC
+                        dst[e].count = atomic_load_explicit(
+                            &err_count[e], memory_order_relaxed);
+                        dst[e].first_id = (uint16_t)atomic_load_explicit(
+                            &err_first[e], memory_order_relaxed);
+                        dst[e].last_id = (uint16_t)atomic_load_explicit(
+                            &err_last[e], memory_order_relaxed);
+#else
+                        dst[e].count = err_count[e];
+                        dst[e].first_id = (uint16_t)err_first[e];
+                        dst[e].last_id = (uint16_t)err_last[e];
+#endif
+                }
+#if !STATUS_ERR_ATOMIC
+                STATUS_EXIT_CRITICAL();
+#endif
+        }
+}
+
+void
+status_set_warning(uint16_t id)
+{
+        set_bit(id, STATUS_CLASS_WARNING);
+}
+
+void
+status_set_fault(uint16_t id)
+{
+        set_bit(id, STATUS_CLASS_FAULT);
+}
+
+void
+status_set_info(uint16_t id)
+{
+        set_bit(id, STATUS_CLASS_INFO);
+}
+
+void
+status_clear_warning(uint16_t id)
+{
+        clear_bit(id, STATUS_CLASS_WARNING, false);
+}
+
+void
+status_clear_fault(uint16_t id)
+{
+        clear_bit(id, STATUS_CLASS_FAULT, false);
+}
+
+void
+status_clear_info(uint16_t id)
+{
+        clear_bit(id, STATUS_CLASS_INFO, false);
+}
+
+#if STATUS_ENABLE_META
+void
+status_ack(enum status_class cls, uint16_t id)
+{
+        clear_bit(id, cls, true);
+}
+#endif
+
+bool
+status_is_warning_set(uint16_t id)
+{
+        return is_bit_set(id, STATUS_CLASS_WARNING);
+}
+
+bool
+status_is_fault_set(uint16_t id)
+{
+        return is_bit_set(id, STATUS_CLASS_FAULT);
+}
+
+bool
+status_is_info_set(uint16_t id)
+{
+        return is_bit_set(id, STATUS_CLASS_INFO);
+}
+
+bool
+status_any(enum status_class cls)
+{
+        const volatile uint16_t *b = get_banks_ro(cls);
+        bool result = false;
+
+        if (b == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
+        } else {
+                STATUS_ENTER_READ();
+                for (size_t i = 0u; (i < NUM_STATUS_BANKS) && !result; ++i) {
+                        if (b[i] != 0u) {
+                                result = true;
+                        }
+                }
+                STATUS_EXIT_READ();
+        }
+
+        return result;
+}
+
+void
+status_clear_all(enum status_class cls)
+{
+        volatile uint16_t *b = get_banks_mut(cls);
+
+        if (b == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
+        } else {
+                STATUS_ENTER_CRITICAL();
+#if STATUS_ENABLE_META
+                for (size_t i = 0u; i < NUM_STATUS_IDS; ++i) {
+                        debounce_count[cls][i] = 0u;
+                }
+#endif
+                for (size_t i = 0u; i < NUM_STATUS_BANKS; ++i) {
+                        const uint16_t old_val = b[i];
+
+                        /* A zero primary may still have a stale shadow. */
+                        if (write_base_locked(cls, (uint16_t)i, old_val)
+                            != 0u) {
+                                b[i] = 0u;
+                                on_bank_change(cls, (uint16_t)i, old_val, 0u);
+                        }
                 }
                 STATUS_EXIT_CRITICAL();
         }
 }
+
+uint16_t
+status_last_fault(void)
+{
+        STATUS_ENTER_READ();
+        uint16_t id = last_fault_id;
+        STATUS_EXIT_READ();
+        return id;
+}
+
+uint16_t
+status_last_warning(void)
+{
+        STATUS_ENTER_READ();
+        uint16_t id = last_warning_id;
+        STATUS_EXIT_READ();
+        return id;
+}
+
+uint16_t
+status_last_info(void)
+{
+        STATUS_ENTER_READ();
+        uint16_t id = last_info_id;
+        STATUS_EXIT_READ();
+        return id;
+}
+
+void
+status_snapshot(enum status_class cls, uint16_t *dst, size_t len)
+{
+        const volatile uint16_t *src = get_banks_ro(cls);
+
+        if (src == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
+        } else if (dst == NULL) {
+                invoke_err_cb(STATUS_ERR_NULL_PTR, STATUS_UNSET_ID);
+        } else if (len == 0u) {
+                invoke_err_cb(STATUS_ERR_INVALID_LEN, STATUS_UNSET_ID);
+        } else {
+                const size_t copy_len = size_min(len, NUM_STATUS_BANKS);
+
+                STATUS_ENTER_READ();
+                for (size_t i = 0u; i < copy_len; ++i) {
+                        dst[i] = src[i];
+                }
+                STATUS_EXIT_READ();
+        }
+}
+
+size_t
+status_query_compile(struct status_query_term *dst, size_t cap,
+                     const uint16_t *ids, size_t n)
+{
+        size_t len = 0u;
+
+        if ((dst == NULL) || (ids == NULL)) {
+                invoke_err_cb(STATUS_ERR_NULL_PTR, STATUS_UNSET_ID);
+                return 0u;
+        }
+        if (n == 0u) {
+                invoke_err_cb(STATUS_ERR_INVALID_LEN, STATUS_UNSET_ID);
+                return 0u;
+        }
+
+        for (size_t k = 0u; k < n; ++k) {
+                const uint16_t bank = status_bank(ids[k]);
+                const uint16_t mask =
+                    (uint16_t)((uint32_t)1u << (uint32_t)status_bit(ids[k]));
+                size_t i = 0u;
+
+                if (bank >= NUM_STATUS_BANKS) {
+                        invoke_err_cb(STATUS_ERR_INVALID_BANK, ids[k]);
+                        return 0u;
+                }
+                /* Terms stay sorted: find the bank or its insertion point. */
+                while ((i < len) && (dst[i].bank < bank)) {
+                        ++i;
+                }
+                if ((i < len) && (dst[i].bank == bank)) {
+                        dst[i].mask |= mask;
+                        continue;
+                }
+                if (len == cap) {
+                        invoke_err_cb(STATUS_ERR_INVALID_LEN, ids[k]);
+                        return 0u;
+                }
+                for (size_t j = len; j > i; --j) {
+                        dst[j] = dst[j - 1u];
+                }
+                dst[i].bank = bank;
+                dst[i].mask = mask;
+                ++len;
+        }
+
+        return len;
+}
+
+bool
+status_query_any(enum status_class cls, const struct status_query_term *terms,
+                 size_t n)
+{
+        return query_run(cls, terms, n, QUERY_ANY, NULL) != 0u;
+}
+
+bool
+status_query_all(enum status_class cls, const struct status_query_term *terms,
+                 size_t n)
+{
+        return query_run(cls, terms, n, QUERY_ALL, NULL) != 0u;
+}
+
+size_t
+status_query_collect(enum status_class cls,
+                     const struct status_query_term *terms, size_t n,
+                     uint16_t *dst)
+{
+        return query_run(cls, terms, n, QUERY_COLLECT, dst);
+}
+
+bool
+status_set_if(enum status_class cls, uint16_t id,
+              const struct status_cond *cond)
+{
+        return cond_update(cls, id, cond, true, true);
+}
+
+bool
+status_clear_unless(enum status_class cls, uint16_t id,
+                    const struct status_cond *cond)
+{
+        return cond_update(cls, id, cond, false, false);
+}
+
+void
+status_field_set(enum status_class cls, status_field_t f, uint16_t value)
+{
+        if (field_valid(cls, f)) {
+                const uint16_t bank = status_field_bank(f);
+                const uint16_t shift = status_field_shift(f);
+                const uint16_t max = field_max(status_field_width(f));
+
+                if (value > max) {
+                        invoke_err_cb(STATUS_ERR_INVALID_ARG,
+                                      STATUS_ENCODE(bank, shift));
+                } else {
+                        volatile uint16_t *b = get_banks_mut(cls);
+                        const uint16_t mask = (uint16_t)(max << shift);
+
+                        STATUS_ENTER_CRITICAL();
+                        const uint16_t old_val = b[bank];
+                        const uint16_t new_val =
+                            (uint16_t)((write_base_locked(cls, bank, old_val)
+                                        & (uint16_t)~mask)
+                                       | (uint16_t)(value << shift));
+                        b[bank] = new_val;
+                        on_bank_change(cls, bank, old_val, new_val);
+                        STATUS_EXIT_CRITICAL();
+                }
+        }
+}
+
+uint16_t
+status_field_get(enum status_class cls, status_field_t f)
+{
+        uint16_t value = 0u;
+
+        if (field_valid(cls, f)) {
+                const volatile uint16_t *b = get_banks_ro(cls);
+
+                STATUS_ENTER_READ();
+                value = b[status_field_bank(f)];
+                STATUS_EXIT_READ();
+                value = (uint16_t)((value >> status_field_shift(f))
+                                   & field_max(status_field_width(f)));
+        }
+
+        return value;
+}
+
+size_t
+status_field_count_at_least(enum status_class cls, uint16_t bank,
+                            uint16_t n_banks, uint16_t width, uint16_t level)
+{
+        return field_scan(cls, bank, n_banks, width, level, false);
+}
+
+bool
+status_field_any_at_least(enum status_class cls, uint16_t bank,
+                          uint16_t n_banks, uint16_t width, uint16_t level)
+{
+        return field_scan(cls, bank, n_banks, width, level, true) != 0u;
+}
+
+#if STATUS_ENABLE_TIME_IN_STATE
+void
+status_time_in_state(enum status_class cls, status_time_t *dst, size_t len)
+{
+        const volatile uint16_t *b = get_banks_ro(cls);
+
+        if (b == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
+        } else if (dst == NULL) {
+                invoke_err_cb(STATUS_ERR_NULL_PTR, STATUS_UNSET_ID);
+        } else if (len == 0u) {
+                invoke_err_cb(STATUS_ERR_INVALID_LEN, STATUS_UNSET_ID);
+        } else {
+                const size_t copy_len = size_min(len, NUM_STATUS_IDS);
+
+                STATUS_ENTER_READ();
+                const status_time_t now = STATUS_TIME_NOW();
+                for (size_t i = 0u; i < copy_len; ++i) {
+                        const uint16_t mask = (uint16_t)((uint32_t)1u << (uint32_t)(i % NUM_STATUS_BITS));
+                        status_time_t t = tis_total[cls][i];
+
+                        /* Include the open interval of active IDs. */
+                        if ((b[i / NUM_STATUS_BITS] & mask) != 0u) {
+                                t = time_add_sat(t, now - set_time[cls][i]);
+                        }
+                        dst[i] = t;
+                }
+                STATUS_EXIT_READ();
+        }
+}
+#endif
+
+#if STATUS_ENABLE_HISTOGRAM
+void
+status_hist_bind(enum status_class cls, uint16_t id, uint8_t slot)
+{
+        uint16_t bank = status_bank(id);
+
+        if (bank >= NUM_STATUS_BANKS) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, id);
+        } else if (get_banks_ro(cls) == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, id);
+        } else if ((slot >= STATUS_HIST_SLOTS) && (slot != STATUS_HIST_NONE)) {
+                invoke_err_cb(STATUS_ERR_INVALID_ARG, id);
+        } else {
+                STATUS_ENTER_CRITICAL();
+                hist_bind[cls][id] =
+                    (slot == STATUS_HIST_NONE) ? 0u : (uint8_t)(slot + 1u);
+                STATUS_EXIT_CRITICAL();
+        }
+}
+
+void
+status_hist_export(uint32_t *dst, size_t len)
+{
+        if (dst == NULL) {
+                invoke_err_cb(STATUS_ERR_NULL_PTR, STATUS_UNSET_ID);
+        } else if (len == 0u) {
+                invoke_err_cb(STATUS_ERR_INVALID_LEN, STATUS_UNSET_ID);
+        } else {
+                const size_t copy_len =
+                    size_min(len, (size_t)STATUS_HIST_SLOTS * STATUS_HIST_BUCKETS);
+
+                STATUS_ENTER_READ();
+                for (size_t i = 0u; i < copy_len; ++i) {
+                        dst[i] = hist_counts[i / STATUS_HIST_BUCKETS]
+                                            [i % STATUS_HIST_BUCKETS];
+                }
+                STATUS_EXIT_READ();
+        }
+}
+#endif
+
+#if STATUS_ENABLE_PRIORITY
+void
+status_set_priority(enum status_class cls, uint16_t id, uint16_t rank)
+{
+        uint16_t bank = status_bank(id);
+        const volatile uint16_t *b = get_banks_ro(cls);
+
+        if (bank >= NUM_STATUS_BANKS) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK, id);
+        } else if (b == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, id);
+        } else if ((rank >= STATUS_PRIO_LEVELS) && (rank != STATUS_PRIO_NONE)) {
+                invoke_err_cb(STATUS_ERR_INVALID_ARG, id);
+        } else {
+                bool taken = false;
+
+                STATUS_ENTER_CRITICAL();
+                const uint16_t owner =
+                    (rank == STATUS_PRIO_NONE) ? 0u : prio_id[cls][rank];
+
+                if ((owner != 0u) && (owner != (uint16_t)(id + 1u))) {
+                        taken = true;
+                } else {
+                        const uint16_t old = prio_rank[cls][id];
+                        const bool active =
+                            (b[bank] & (uint16_t)((uint32_t)1u << status_bit(id)))
+                            != 0u;
+
+                        if (old != 0u) {
+                                prio_id[cls][old - 1u] = 0u;
+                                prio_mark(cls, (uint16_t)(old - 1u), false);
+                        }
+                        if (rank != STATUS_PRIO_NONE) {
+                                prio_rank[cls][id] = (uint16_t)(rank + 1u);
+                                prio_id[cls][rank] = (uint16_t)(id + 1u);
+                                prio_mark(cls, rank, active);
+                        } else {
+                                prio_rank[cls][id] = 0u;
+                        }
+                }
+                STATUS_EXIT_CRITICAL();
+
+                if (taken) {
+                        invoke_err_cb(STATUS_ERR_INVALID_ARG, id);
+                }
+        }
+}
+
+uint16_t
+status_highest_active(enum status_class cls)
+{
+        uint16_t id = STATUS_UNSET_ID;
+
+        if (get_banks_ro(cls) == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
+        } else {
+                STATUS_ENTER_READ();
+                const uint32_t summary = prio_summary[cls];
+
+                if (summary != 0u) {
+                        const unsigned int w = bit_msb32(summary);
+                        const unsigned int r =
+                            (w * 32u) + bit_msb32(prio_words[cls][w]);
+
+                        id = (uint16_t)(prio_id[cls][r] - 1u);
+                }
+                STATUS_EXIT_READ();
+        }
+
+        return id;
+}
+#endif
+
+#if STATUS_ENABLE_INTEGRITY
+bool
+status_verify(enum status_class cls)
+{
+        bool ok = false;
+
+        if (get_banks_ro(cls) == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
+        } else {
+                STATUS_ENTER_READ();
+                ok = (chk_sum[cls] == ~chk_inv[cls]);
+                STATUS_EXIT_READ();
+
+                if (!ok) {
+                        invoke_err_cb(STATUS_ERR_INTEGRITY, STATUS_UNSET_ID);
+                }
+        }
+
+        return ok;
+}
+
+bool
+status_verify_step(enum status_class cls, size_t n)
+{
+        const volatile uint16_t *b = get_banks_ro(cls);
+        bool ok = true;
+
+        if (b == NULL) {
+                invoke_err_cb(STATUS_ERR_INVALID_ID, STATUS_UNSET_ID);
+                ok = false;
+        } else {
+                STATUS_ENTER_CRITICAL();
+                for (size_t k = 0u; k < n; ++k) {
+                        const uint16_t i = chk_cursor[cls];
+
+                        chk_partial[cls] += (uint32_t)b[i] * CHK_WEIGHT(i);
+                        if ((i + 1u) < NUM_STATUS_BANKS) {
+                                chk_cursor[cls] = (uint16_t)(i + 1u);
+                        } else {
+                                ok = (chk_partial[cls] == chk_sum[cls])
+                                     && (chk_sum[cls] == ~chk_inv[cls]);
+                                chk_partial[cls] = 0u;
+                                chk_cursor[cls] = 0u;
+                                break;
+                        }
+                }
+                STATUS_EXIT_CRITICAL();
+
+                if (!ok) {
+                        invoke_err_cb(STATUS_ERR_INTEGRITY, STATUS_UNSET_ID);
+                }
+        }
+
+        return ok;
+}
+#endif
+
+#if STATUS_ENABLE_SHADOW
+size_t
+status_scrub_step(size_t n)
+{
+        size_t repaired;
+        uint16_t fixed_id;
+
+        STATUS_ENTER_CRITICAL();
+        repaired = shadow_fixed;
+        fixed_id = shadow_fixed_id;
+        shadow_fixed = 0u;
+        shadow_fixed_id = STATUS_UNSET_ID;
+        STATUS_EXIT_CRITICAL();
+        if (repaired > 0u) {
+                invoke_err_cb(STATUS_ERR_INTEGRITY, fixed_id);
+        }
+
+        for (size_t k = 0u; k < n; ++k) {
+                uint16_t diff;
+                uint16_t bank;
+
+                STATUS_ENTER_CRITICAL();
+                const size_t pos = scrub_cursor;
+                const enum status_class cls =
+                    (enum status_class)(pos / NUM_STATUS_BANKS);
+                volatile uint16_t *b = get_banks_mut(cls);
+
+                bank = (uint16_t)(pos % NUM_STATUS_BANKS);
+                scrub_cursor = (pos + 1u) % SCRUB_SPAN;
+
+                const uint16_t old_val = b[bank];
+                const uint16_t ref = (uint16_t)~shadow_banks[cls][bank];
+
+                diff = (uint16_t)(old_val ^ ref);
+                if (diff != 0u) {
+                        const uint16_t new_val = (uint16_t)(old_val | ref);
+
+                        b[bank] = new_val;
+                        on_bank_change(cls, bank, old_val, new_val);
+                }
+                STATUS_EXIT_CRITICAL();
+
+                if (diff != 0u) {
+                        ++repaired;
+                        invoke_err_cb(STATUS_ERR_INTEGRITY,
+                                      STATUS_ENCODE(bank, bit_ctz16(diff)));
+                }
+        }
+
+        return repaired;
+}
+#endif
+
+#if STATUS_ENABLE_SOURCES
+void
+status_source_set(enum status_class cls, uint16_t id, uint8_t src)
+{
+        source_update(cls, id, src, true);
+}
+
+void
+status_source_clear(enum status_class cls, uint16_t id, uint8_t src)
+{
+        source_update(cls, id, src, false);
+}
+
+uint32_t
+status_source_mask(enum status_class cls, uint16_t id)
+{
+        uint32_t result = 0u;
+
+        if ((status_bank(id) < NUM_STATUS_BANKS) && (get_banks_ro(cls) != NULL)) {
+                STATUS_ENTER_READ();
+                result = source_masks[cls][id];
+                STATUS_EXIT_READ();
+        }
+
+        return result;
+}
+#endif
+
+#if STATUS_ENABLE_BANK_ALLOC
+uint16_t
+status_bank_alloc(uint16_t n_banks, uint8_t owner)
+{
+        uint16_t first = STATUS_BANK_NONE;
+
+        if (n_banks == 0u) {
+                invoke_err_cb(STATUS_ERR_INVALID_LEN, STATUS_UNSET_ID);
+                return STATUS_BANK_NONE;
+        }
+#if STATUS_ENABLE_BANK_OWNERS
+        if (owner == STATUS_OWNER_NONE) {
+                invoke_err_cb(STATUS_ERR_INVALID_ARG, STATUS_UNSET_ID);
+                return STATUS_BANK_NONE;
+        }
+#else
+        (void)owner;
+#endif
+
+        STATUS_ENTER_CRITICAL();
+        size_t pos = alloc_next(STATUS_BANK_ALLOC_FIRST, true);
+
+        while (pos < NUM_STATUS_BANKS) {
+                const size_t end = alloc_next(pos, false);
+
+                if ((end - pos) >= n_banks) {
+                        alloc_mark(pos, n_banks, false);
+#if STATUS_ENABLE_BANK_OWNERS
+                        for (size_t i = pos; i < (pos + n_banks); ++i) {
+                                bank_owner[i] = owner;
+                        }
+#endif
+                        first = (uint16_t)pos;
+                        break;
+                }
+                pos = alloc_next(end, true);
+        }
+        STATUS_EXIT_CRITICAL();
+
+        return first;
+}
+
+void
+status_bank_free(uint16_t first, uint16_t n_banks, uint8_t owner)
+{
+        /* Offset into the managed banks; wraps for banks below them. */
+        const uint32_t rel = (uint32_t)first - STATUS_BANK_ALLOC_FIRST;
+        const uint32_t span = NUM_STATUS_BANKS - STATUS_BANK_ALLOC_FIRST;
+        status_err_t err = STATUS_ERR_INVALID_ARG;
+        size_t bad = NUM_STATUS_BANKS;
+
+        if ((rel > span) || (n_banks > (span - rel))) {
+                invoke_err_cb(STATUS_ERR_INVALID_BANK,
+                              STATUS_ENCODE(first, 0u));
+                return;
+        }
+
+        STATUS_ENTER_CRITICAL();
+        for (size_t i = first; i < ((size_t)first + n_banks); ++i) {
+                if ((bank_free_map[i / 32u] & ((uint32_t)1u << (i % 32u)))
+                    != 0u) {
+                        bad = i;
+                        break;
+                }
+#if STATUS_ENABLE_BANK_OWNERS
+                if (bank_owner[i] != owner) {
+                        err = STATUS_ERR_NOT_OWNER;
+                        bad = i;
+                        break;
+                }
+#endif
+        }
+        if (bad == NUM_STATUS_BANKS) {
+                for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                        volatile uint16_t *b =
+                            get_banks_mut((enum status_class)c);
+
+                        for (uint16_t i = first; i < (first + n_banks); ++i) {
+                                const uint16_t old_val = b[i];
+
+                                if (write_base_locked((enum status_class)c, i,
+                                                      old_val)
+                                    != 0u) {
+                                        b[i] = 0u;
+                                        on_bank_change((enum status_class)c, i,
+                                                       old_val, 0u);
+                                }
+                        }
+                }
+#if STATUS_ENABLE_BANK_OWNERS
+                for (size_t i = first; i < ((size_t)first + n_banks); ++i) {
+                        bank_owner[i] = STATUS_OWNER_NONE;
+                }
+#endif
+                alloc_mark(first, n_banks, true);
+        }
+        STATUS_EXIT_CRITICAL();
+
+#if !STATUS_ENABLE_BANK_OWNERS
+        (void)owner;
+#endif
+        if (bad != NUM_STATUS_BANKS) {
+                invoke_err_cb(err, STATUS_ENCODE(bad, 0u));
+        }
+}
+#endif
+
+#if STATUS_ENABLE_BANK_OWNERS
+uint8_t
+status_bank_owner(uint16_t bank)
+{
+        uint8_t owner = STATUS_OWNER_NONE;
+
+        if (bank < NUM_STATUS_BANKS) {
+                STATUS_ENTER_READ();
+                owner = bank_owner[bank];
+                STATUS_EXIT_READ();
+        }
+
+        return owner;
+}
+
+void
+status_set_owned(enum status_class cls, uint16_t id, uint8_t owner)
+{
+        owned_update(cls, id, owner, true);
+}
+
+void
+status_clear_owned(enum status_class cls, uint16_t id, uint8_t owner)
+{
+        owned_update(cls, id, owner, false);
+}
+#endif
+
+#if STATUS_ENABLE_DIRTY
+bool
+status_dirty_next(enum status_class *cls, uint16_t *bank, uint16_t *value)
+{
+        bool found = false;
+
+        if ((cls == NULL) || (bank == NULL) || (value == NULL)) {
+                invoke_err_cb(STATUS_ERR_NULL_PTR, STATUS_UNSET_ID);
+                return false;
+        }
+
+        STATUS_ENTER_CRITICAL();
+        for (size_t c = 0u; (c < NUM_STATUS_CLASSES) && !found; ++c) {
+                for (size_t w = 0u; w < DIRTY_WORDS; ++w) {
+                        const uint32_t m = dirty_map[c][w];
+
+                        if (m != 0u) {
+                                const uint16_t i =
+                                    (uint16_t)((w * 32u) + bit_ctz32(m));
+
+                                dirty_map[c][w] = m & (m - 1u);
+                                *cls = (enum status_class)c;
+                                *bank = i;
+                                *value = get_banks_ro(*cls)[i];
+                                found = true;
+                                break;
+                        }
+                }
+        }
+        STATUS_EXIT_CRITICAL();
+
+        return found;
+}
+
+void
+status_dirty_clear(void)
+{
+        STATUS_ENTER_CRITICAL();
+        for (size_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                for (size_t w = 0u; w < DIRTY_WORDS; ++w) {
+                        dirty_map[c][w] = 0u;
+                }
+        }
+        STATUS_EXIT_CRITICAL();
+}
+#endif
+
+#if STATUS_ENABLE_EDGE_HOOK
+void
+status_set_edge_hook(status_edge_cb_t cb, void *ctx)
+{
+        STATUS_ENTER_CRITICAL();
+        edge_cb = cb;
+        edge_ctx = ctx;
+        STATUS_EXIT_CRITICAL();
+}
+#endif
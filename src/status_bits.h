@@ -0,0 +1,86 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_bits.h
+ *
+ * @brief Bit-scan helpers shared by the library sources. Internal; not
+ *        installed.
+ */
+
+#ifndef STATUS_BITS_H
+#define STATUS_BITS_H
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdint.h>
+
+/* ================ STATIC FUNCTIONS ======================================== */
+
+/* Index of the least significant set bit; x must be non-zero. */
+static inline unsigned int
+bit_ctz16(uint16_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+        return (unsigned int)__builtin_ctz((unsigned int)x);
+#else
+        unsigned int n = 0u;
+
+        while ((x & 1u) == 0u) {
+                x = (uint16_t)(x >> 1u);
+                ++n;
+        }
+        return n;
+#endif
+}
+
+/* Index of the least significant set bit; x must be non-zero. */
+static inline unsigned int
+bit_ctz32(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+        return (unsigned int)__builtin_ctzl((unsigned long)x);
+#else
+        unsigned int n = 0u;
+
+        while ((x & 1u) == 0u) {
+                x >>= 1u;
+                ++n;
+        }
+        return n;
+#endif
+}
+
+static inline unsigned int
+bit_popcount16(uint16_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+        return (unsigned int)__builtin_popcount((unsigned int)x);
+#else
+        unsigned int n = 0u;
+
+        while (x != 0u) {
+                x &= (uint16_t)(x - 1u);
+                ++n;
+        }
+        return n;
+#endif
+}
+
+/* Index of the most significant set bit; x must be non-zero. */
+static inline unsigned int
+bit_msb32(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+        return (unsigned int)(31 - __builtin_clz((unsigned int)x));
+#else
+        unsigned int n = 0u;
+
+        while ((x >> 1u) != 0u) {
+                x >>= 1u;
+                ++n;
+        }
+        return n;
+#endif
+}
+
+#endif /* STATUS_BITS_H */
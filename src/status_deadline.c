@@ -0,0 +1,354 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_deadline.c
+ *
+ * @brief Min-heap driven deadline monitor for periodic events.
+ */
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+#include "status_deadline.h"
+
+/* ================ DEFINES ================================================= */
+
+/* ---------------- Configuration ------------------------------------------- */
+
+/*
+ * Handles and heap positions are stored as uint16_t with 0xFFFF reserved as a
+ * sentinel.
+ */
+_Static_assert(STATUS_DEADLINE_MAX < 0xFFFFu,
+               "STATUS_DEADLINE_MAX must be < 0xFFFF");
+
+/* Marks a slot that is not currently in the heap. */
+#define HEAP_NONE (0xFFFFu)
+
+/* Largest representable interval under modulo-2^32 comparison. */
+#define MAX_PERIOD (0x7FFFFFFFu)
+
+/* ================ STRUCTURES ============================================== */
+
+struct deadline_slot {
+        status_time_t deadline;
+        status_time_t period;
+        uint16_t id;
+        uint16_t heap_pos; /* HEAP_NONE when disarmed or expired */
+        uint16_t gen;      /* bumped on every expire / recover */
+        uint8_t cls;
+        bool in_use;
+        bool expired;
+};
+
+/* ================ STATIC VARIABLES ======================================== */
+
+static struct deadline_slot slots[STATUS_DEADLINE_MAX];
+
+/* Min-heap of slot indices ordered by deadline. */
+static uint16_t heap[STATUS_DEADLINE_MAX];
+static size_t heap_len;
+
+/* ================ STATIC FUNCTIONS ======================================== */
+
+/* True if `a` is strictly before `b` under modulo-2^32 arithmetic. */
+static inline bool
+time_before(status_time_t a, status_time_t b)
+{
+        return (uint32_t)(a - b) > MAX_PERIOD;
+}
+
+static inline bool
+heap_less(size_t i, size_t j)
+{
+        return time_before(slots[heap[i]].deadline, slots[heap[j]].deadline);
+}
+
+static inline void
+heap_swap(size_t i, size_t j)
+{
+        uint16_t tmp = heap[i];
+
+        heap[i] = heap[j];
+        heap[j] = tmp;
+        slots[heap[i]].heap_pos = (uint16_t)i;
+        slots[heap[j]].heap_pos = (uint16_t)j;
+}
+
+static void
+heap_sift_up(size_t i)
+{
+        while (i > 0u) {
+                size_t parent = (i - 1u) / 2u;
+
+                if (!heap_less(i, parent)) {
+                        break;
+                }
+                heap_swap(i, parent);
+                i = parent;
+        }
+}
+
+static void
+heap_sift_down(size_t i)
+{
+        for (;;) {
+                size_t l = (2u * i) + 1u;
+                size_t r = l + 1u;
+                size_t m = i;
+
+                if ((l < heap_len) && heap_less(l, m)) {
+                        m = l;
+                }
+                if ((r < heap_len) && heap_less(r, m)) {
+                        m = r;
+                }
+                if (m == i) {
+                        break;
+                }
+                heap_swap(i, m);
+                i = m;
+        }
+}
+
+static void
+heap_push(uint16_t slot)
+{
+        size_t i = heap_len++;
+
+        heap[i] = slot;
+        slots[slot].heap_pos = (uint16_t)i;
+        heap_sift_up(i);
+}
+
+static void
+heap_remove(uint16_t slot)
+{
+        size_t i = slots[slot].heap_pos;
+        size_t last = --heap_len;
+
+        slots[slot].heap_pos = HEAP_NONE;
+        if (i != last) {
+                heap[i] = heap[last];
+                slots[heap[i]].heap_pos = (uint16_t)i;
+                heap_sift_up(i);
+                heap_sift_down(slots[heap[i]].heap_pos);
+        }
+}
+
+static inline bool
+handle_valid(status_deadline_t h)
+{
+        return (h < STATUS_DEADLINE_MAX) && slots[h].in_use;
+}
+
+static void
+apply_bit(enum status_class cls, uint16_t id, bool set)
+{
+        switch (cls) {
+        case STATUS_CLASS_FAULT:
+                if (set) {
+                        status_set_fault(id);
+                } else {
+                        status_clear_fault(id);
+                }
+                break;
+        case STATUS_CLASS_WARNING:
+                if (set) {
+                        status_set_warning(id);
+                } else {
+                        status_clear_warning(id);
+                }
+                break;
+        case STATUS_CLASS_INFO:
+                if (set) {
+                        status_set_info(id);
+                } else {
+                        status_clear_info(id);
+                }
+                break;
+        default: break;
+        }
+}
+
+/*
+ * Bring the register in line with slot `s` after an expire or recover at
+ * generation `gen`. The bit is written outside our critical section, so a
+ * tick and a kick on the same slot can apply their writes in the opposite
+ * order of their state changes. Whoever writes last re-reads the slot and
+ * repeats with its current state if the generation moved meanwhile.
+ */
+static void
+apply_slot(uint16_t s, uint16_t gen, enum status_class cls, uint16_t id,
+           bool set)
+{
+        for (;;) {
+                bool again;
+
+                apply_bit(cls, id, set);
+
+                STATUS_ENTER_CRITICAL();
+                again = slots[s].in_use && (slots[s].gen != gen);
+                gen = slots[s].gen;
+                set = slots[s].expired;
+                cls = (enum status_class)slots[s].cls;
+                id = slots[s].id;
+                STATUS_EXIT_CRITICAL();
+
+                if (!again) {
+                        break;
+                }
+        }
+}
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+void
+status_deadline_init(void)
+{
+        STATUS_ENTER_CRITICAL();
+        for (size_t i = 0u; i < STATUS_DEADLINE_MAX; ++i) {
+                slots[i].in_use = false;
+                slots[i].expired = false;
+                slots[i].heap_pos = HEAP_NONE;
+                slots[i].gen = 0u;
+        }
+        heap_len = 0u;
+        STATUS_EXIT_CRITICAL();
+}
+
+status_deadline_t
+status_deadline_register(enum status_class cls, uint16_t id,
+                         status_time_t period, status_time_t now)
+{
+        status_deadline_t h = STATUS_DEADLINE_INVALID;
+        bool valid = ((cls == STATUS_CLASS_FAULT)
+                      || (cls == STATUS_CLASS_WARNING)
+                      || (cls == STATUS_CLASS_INFO))
+                     && (status_bank(id) < NUM_STATUS_BANKS) && (period != 0u)
+                     && (period <= MAX_PERIOD);
+
+        if (valid) {
+                STATUS_ENTER_CRITICAL();
+                for (size_t i = 0u; i < STATUS_DEADLINE_MAX; ++i) {
+                        if (!slots[i].in_use) {
+                                slots[i].in_use = true;
+                                slots[i].expired = false;
+                                slots[i].cls = (uint8_t)cls;
+                                slots[i].id = id;
+                                slots[i].period = period;
+                                slots[i].deadline = now + period;
+                                heap_push((uint16_t)i);
+                                h = (status_deadline_t)i;
+                                break;
+                        }
+                }
+                STATUS_EXIT_CRITICAL();
+        }
+
+        return h;
+}
+
+void
+status_deadline_unregister(status_deadline_t h)
+{
+        STATUS_ENTER_CRITICAL();
+        if (handle_valid(h)) {
+                if (slots[h].heap_pos != HEAP_NONE) {
+                        heap_remove(h);
+                }
+                slots[h].in_use = false;
+                slots[h].expired = false;
+        }
+        STATUS_EXIT_CRITICAL();
+}
+
+void
+status_deadline_kick(status_deadline_t h, status_time_t now)
+{
+        bool recovered = false;
+        enum status_class cls = STATUS_CLASS_FAULT;
+        uint16_t id = 0u;
+        uint16_t gen = 0u;
+
+        STATUS_ENTER_CRITICAL();
+        if (handle_valid(h)) {
+                slots[h].deadline = now + slots[h].period;
+                if (slots[h].heap_pos == HEAP_NONE) {
+                        heap_push(h);
+                } else {
+                        /*
+                         * Usually later, but earlier if the clock stepped
+                         * back: sift both ways.
+                         */
+                        heap_sift_up(slots[h].heap_pos);
+                        heap_sift_down(slots[h].heap_pos);
+                }
+                if (slots[h].expired) {
+                        slots[h].expired = false;
+                        gen = ++slots[h].gen;
+                        recovered = true;
+                        cls = (enum status_class)slots[h].cls;
+                        id = slots[h].id;
+                }
+        }
+        STATUS_EXIT_CRITICAL();
+
+        /* Touch the register outside our critical section. */
+        if (recovered) {
+                apply_slot(h, gen, cls, id, false);
+        }
+}
+
+size_t
+status_deadline_tick(status_time_t now)
+{
+        size_t expired = 0u;
+
+        for (;;) {
+                bool fire = false;
+                enum status_class cls = STATUS_CLASS_FAULT;
+                uint16_t id = 0u;
+                uint16_t s = 0u;
+                uint16_t gen = 0u;
+
+                STATUS_ENTER_CRITICAL();
+                if ((heap_len > 0u)
+                    && !time_before(now, slots[heap[0]].deadline)) {
+                        s = heap[0];
+                        heap_remove(s);
+                        slots[s].expired = true;
+                        gen = ++slots[s].gen;
+                        cls = (enum status_class)slots[s].cls;
+                        id = slots[s].id;
+                        fire = true;
+                }
+                STATUS_EXIT_CRITICAL();
+
+                if (!fire) {
+                        break;
+                }
+                apply_slot(s, gen, cls, id, true);
+                ++expired;
+        }
+
+        return expired;
+}
+
+bool
+status_deadline_expired(status_deadline_t h)
+{
+        bool result = false;
+
+        STATUS_ENTER_READ();
+        if (handle_valid(h)) {
+                result = slots[h].expired;
+        }
+        STATUS_EXIT_READ();
+
+        return result;
+}
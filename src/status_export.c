@@ -0,0 +1,348 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_export.c
+ *
+ * @brief Resumable JSON/CBOR serialiser for the active status IDs.
+ */
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "status.h"
+#include "status_bits.h"
+#include "status_export.h"
+
+/* ================ DEFINES ================================================= */
+
+#define NUM_STATUS_CLASSES (3u)
+#define NUM_STATUS_IDS     ((uint32_t)NUM_STATUS_BANKS * NUM_STATUS_BITS)
+
+_Static_assert(NUM_STATUS_IDS <= 0xFFFFu,
+               "active ID counts must fit in uint16_t");
+
+/* CBOR major types (RFC 8949), pre-shifted. */
+#define CBOR_UINT  (0x00u)
+#define CBOR_TEXT  (0x60u)
+#define CBOR_ARRAY (0x80u)
+#define CBOR_MAP   (0xA0u)
+
+/* ================ STRUCTURES ============================================== */
+
+/*
+ * Document position. Each state emits at most one token into `pend`; only
+ * ST_NAME writes straight into the caller's buffer.
+ */
+enum export_state {
+        ST_OPEN = 0, /* document header */
+        ST_KEY,      /* class key and array header */
+        ST_ITEM,     /* next active ID (or end of class) */
+        ST_NAME,     /* name characters */
+        ST_ITEM_END, /* JSON: close the {"id","name"} object */
+        ST_DONE,
+};
+
+/* ================ STATIC VARIABLES ======================================== */
+
+static const char *const class_key[NUM_STATUS_CLASSES] = {
+        [STATUS_CLASS_FAULT] = "fault",
+        [STATUS_CLASS_WARNING] = "warning",
+        [STATUS_CLASS_INFO] = "info",
+};
+
+/* ================ STATIC FUNCTIONS ======================================== */
+
+static inline void
+pend_byte(struct status_exporter *x, uint8_t c)
+{
+        x->pend[x->pend_len++] = c;
+}
+
+static void
+pend_str(struct status_exporter *x, const char *s)
+{
+        while (*s != '\0') {
+                pend_byte(x, (uint8_t)*s++);
+        }
+}
+
+static void
+pend_u16(struct status_exporter *x, uint16_t v)
+{
+        uint8_t tmp[5];
+        size_t n = 0u;
+
+        do {
+                tmp[n++] = (uint8_t)('0' + (v % 10u));
+                v = (uint16_t)(v / 10u);
+        } while (v != 0u);
+        while (n > 0u) {
+                pend_byte(x, tmp[--n]);
+        }
+}
+
+/* CBOR initial byte plus big-endian argument of the shortest form. */
+static void
+pend_cbor(struct status_exporter *x, uint8_t major, uint64_t v)
+{
+        unsigned int n;
+
+        if (v < 24u) {
+                pend_byte(x, (uint8_t)(major | v));
+                return;
+        }
+        if (v <= 0xFFu) {
+                pend_byte(x, (uint8_t)(major | 24u));
+                n = 1u;
+        } else if (v <= 0xFFFFu) {
+                pend_byte(x, (uint8_t)(major | 25u));
+                n = 2u;
+        } else if (v <= 0xFFFFFFFFu) {
+                pend_byte(x, (uint8_t)(major | 26u));
+                n = 4u;
+        } else {
+                pend_byte(x, (uint8_t)(major | 27u));
+                n = 8u;
+        }
+        while (n > 0u) {
+                --n;
+                pend_byte(x, (uint8_t)(v >> (8u * n)));
+        }
+}
+
+/* Advance `pos` to the next active ID of the current class. */
+static bool
+next_active(struct status_exporter *x, uint16_t *id)
+{
+        const uint16_t *b = x->banks[x->cls];
+
+        while (x->pos < NUM_STATUS_IDS) {
+                const uint32_t bank = x->pos / NUM_STATUS_BITS;
+                const uint32_t bit = x->pos % NUM_STATUS_BITS;
+                const uint16_t m = (uint16_t)(b[bank] & (0xFFFFu << bit));
+
+                if (m != 0u) {
+                        *id = (uint16_t)((bank * NUM_STATUS_BITS)
+                                         + bit_ctz16(m));
+                        x->pos = (uint32_t)*id + 1u;
+                        return true;
+                }
+                x->pos = (bank + 1u) * NUM_STATUS_BITS;
+        }
+
+        return false;
+}
+
+/* Produce the next token into `pend` and advance the state. */
+static void
+next_token(struct status_exporter *x)
+{
+        const bool json = (x->fmt == STATUS_EXPORT_JSON);
+        uint16_t id;
+
+        x->pend_len = 0u;
+        x->pend_off = 0u;
+
+        switch ((enum export_state)x->state) {
+        case ST_OPEN:
+                if (json) {
+                        pend_byte(x, '{');
+                } else {
+                        pend_cbor(x, CBOR_MAP, NUM_STATUS_CLASSES);
+                }
+                x->state = ST_KEY;
+                break;
+        case ST_KEY:
+                if (json) {
+                        if (x->cls != 0u) {
+                                pend_byte(x, ',');
+                        }
+                        pend_byte(x, '"');
+                        pend_str(x, class_key[x->cls]);
+                        pend_str(x, "\":[");
+                } else {
+                        pend_cbor(x, CBOR_TEXT, strlen(class_key[x->cls]));
+                        pend_str(x, class_key[x->cls]);
+                        pend_cbor(x, CBOR_ARRAY, x->count[x->cls]);
+                }
+                x->pos = 0u;
+                x->emitted = 0u;
+                x->state = ST_ITEM;
+                break;
+        case ST_ITEM:
+                if (!next_active(x, &id)) {
+                        if (json) {
+                                pend_byte(x, ']');
+                        }
+                        if (++x->cls < NUM_STATUS_CLASSES) {
+                                x->state = ST_KEY;
+                        } else {
+                                if (json) {
+                                        pend_byte(x, '}');
+                                }
+                                x->state = ST_DONE;
+                        }
+                        break;
+                }
+                x->name = (x->name_fn != NULL)
+                              ? x->name_fn((enum status_class)x->cls, id)
+                              : NULL;
+                if (json && (x->emitted != 0u)) {
+                        pend_byte(x, ',');
+                }
+                ++x->emitted;
+                if (x->name == NULL) {
+                        if (json) {
+                                pend_u16(x, id);
+                        } else {
+                                pend_cbor(x, CBOR_UINT, id);
+                        }
+                        break;
+                }
+                x->name_len = strlen(x->name);
+                x->name_off = 0u;
+                if (json) {
+                        pend_str(x, "{\"id\":");
+                        pend_u16(x, id);
+                        pend_str(x, ",\"name\":\"");
+                } else {
+                        pend_cbor(x, CBOR_ARRAY, 2u);
+                        pend_cbor(x, CBOR_UINT, id);
+                        pend_cbor(x, CBOR_TEXT, x->name_len);
+                }
+                x->state = ST_NAME;
+                break;
+        case ST_ITEM_END:
+                pend_str(x, "\"}");
+                x->state = ST_ITEM;
+                break;
+        case ST_NAME:
+        case ST_DONE:
+        default: break;
+        }
+}
+
+/*
+ * Copy name characters straight into `dst`. JSON escapes are staged in
+ * `pend` so they are never split by the caller's buffer.
+ */
+static size_t
+name_chunk(struct status_exporter *x, uint8_t *dst, size_t cap)
+{
+        const bool json = (x->fmt == STATUS_EXPORT_JSON);
+        const char *s = x->name + x->name_off;
+        size_t left = x->name_len - x->name_off;
+        size_t run = 0u;
+
+        if (left == 0u) {
+                x->state = json ? ST_ITEM_END : ST_ITEM;
+                return 0u;
+        }
+        if (!json) {
+                run = (left < cap) ? left : cap;
+        } else {
+                while ((run < left) && (run < cap)) {
+                        const unsigned char c = (unsigned char)s[run];
+
+                        if ((c == '"') || (c == '\\') || (c < 0x20u)) {
+                                break;
+                        }
+                        ++run;
+                }
+                if (run == 0u) {
+                        static const char hex[] = "0123456789abcdef";
+                        const unsigned char c = (unsigned char)s[0];
+
+                        x->pend_len = 0u;
+                        x->pend_off = 0u;
+                        pend_byte(x, '\\');
+                        if (c >= 0x20u) {
+                                pend_byte(x, c);
+                        } else {
+                                pend_str(x, "u00");
+                                pend_byte(x, (uint8_t)hex[c >> 4u]);
+                                pend_byte(x, (uint8_t)hex[c & 0xFu]);
+                        }
+                        x->name_off++;
+                        return 0u;
+                }
+        }
+        memcpy(dst, s, run);
+        x->name_off += run;
+
+        return run;
+}
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+void
+status_export_begin(struct status_exporter *x, enum status_export_format fmt,
+                    status_export_name_fn name_fn)
+{
+        if (x == NULL) {
+                return;
+        }
+
+        x->fmt = (uint8_t)fmt;
+        x->name_fn = name_fn;
+        x->name = NULL;
+        x->cls = 0u;
+        x->pend_len = 0u;
+        x->pend_off = 0u;
+        x->state = ((fmt == STATUS_EXPORT_JSON) || (fmt == STATUS_EXPORT_CBOR))
+                       ? ST_OPEN
+                       : ST_DONE;
+
+        for (uint8_t c = 0u; c < NUM_STATUS_CLASSES; ++c) {
+                uint16_t n = 0u;
+
+                status_snapshot((enum status_class)c, x->banks[c],
+                                NUM_STATUS_BANKS);
+                for (size_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                        n = (uint16_t)(n + bit_popcount16(x->banks[c][b]));
+                }
+                x->count[c] = n;
+        }
+}
+
+size_t
+status_export_step(struct status_exporter *x, uint8_t *dst, size_t cap)
+{
+        size_t n = 0u;
+
+        if ((x == NULL) || (dst == NULL)) {
+                return 0u;
+        }
+
+        while (n < cap) {
+                if (x->pend_off < x->pend_len) {
+                        size_t k = (size_t)(x->pend_len - x->pend_off);
+
+                        if (k > (cap - n)) {
+                                k = cap - n;
+                        }
+                        memcpy(&dst[n], &x->pend[x->pend_off], k);
+                        x->pend_off = (uint8_t)(x->pend_off + k);
+                        n += k;
+                } else if (x->state == ST_NAME) {
+                        n += name_chunk(x, &dst[n], cap - n);
+                } else if (x->state == ST_DONE) {
+                        break;
+                } else {
+                        next_token(x);
+                }
+        }
+
+        return n;
+}
+
+bool
+status_export_done(const struct status_exporter *x)
+{
+        return (x == NULL)
+               || ((x->state == ST_DONE) && (x->pend_off >= x->pend_len));
+}
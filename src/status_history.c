@@ -0,0 +1,243 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_history.c
+ *
+ * @brief Checkpoint + XOR-delta history of the register.
+ */
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "status.h"
+#include "status_history.h"
+
+/* ================ DEFINES ================================================= */
+
+/* ---------------- Configuration ------------------------------------------- */
+
+/*
+ * With a single segment, starting a checkpoint would overwrite the only
+ * base that the retained deltas replay from.
+ */
+_Static_assert(STATUS_HISTORY_CHECKPOINTS >= 2u,
+               "STATUS_HISTORY_CHECKPOINTS must be >= 2");
+_Static_assert(STATUS_HISTORY_DELTAS >= 1u,
+               "STATUS_HISTORY_DELTAS must be >= 1");
+
+#define NUM_CLASSES (3u)
+#define NUM_WORDS   ((size_t)NUM_CLASSES * NUM_STATUS_BANKS)
+
+/* Largest representable interval under modulo-2^32 comparison. */
+#define MAX_SPAN (0x7FFFFFFFu)
+
+/* ================ STRUCTURES ============================================== */
+
+/* One changed bank: word index (cls * NUM_STATUS_BANKS + bank) and flips. */
+struct history_delta {
+        status_time_t time;
+        uint16_t word;
+        uint16_t flip;
+};
+
+/* A full checkpoint followed by the deltas sampled after it. */
+struct history_segment {
+        status_time_t time;
+        size_t n_deltas;
+        uint16_t banks[NUM_WORDS];
+        struct history_delta deltas[STATUS_HISTORY_DELTAS];
+};
+
+/* ================ STATIC VARIABLES ======================================== */
+
+static struct history_segment segs[STATUS_HISTORY_CHECKPOINTS];
+static size_t seg_tail; /* oldest segment */
+static size_t seg_count;
+
+/* State of the latest sample, and a scratch copy for the next one. */
+static uint16_t cur[NUM_WORDS];
+static uint16_t next[NUM_WORDS];
+static status_time_t last_time;
+
+/* ================ STATIC FUNCTIONS ======================================== */
+
+/* True if `a` is strictly before `b` under modulo-2^32 arithmetic. */
+static inline bool
+time_before(status_time_t a, status_time_t b)
+{
+        return (uint32_t)(a - b) > MAX_SPAN;
+}
+
+/* k-th segment counted from the oldest. */
+static inline struct history_segment *
+seg_at(size_t k)
+{
+        return &segs[(seg_tail + k) % STATUS_HISTORY_CHECKPOINTS];
+}
+
+/* Newest segment whose checkpoint is not after `t`; `t` must be retained. */
+static const struct history_segment *
+seg_find(status_time_t t)
+{
+        const status_time_t base = seg_at(0u)->time;
+        const uint32_t rt = (uint32_t)(t - base);
+        size_t lo = 0u;
+        size_t hi = seg_count - 1u;
+
+        while (lo < hi) {
+                const size_t mid = lo + ((hi - lo + 1u) / 2u);
+
+                if ((uint32_t)(seg_at(mid)->time - base) <= rt) {
+                        lo = mid;
+                } else {
+                        hi = mid - 1u;
+                }
+        }
+
+        return seg_at(lo);
+}
+
+/* Start a new segment at `now` from `next`, evicting the oldest if full. */
+static void
+checkpoint(status_time_t now)
+{
+        struct history_segment *s;
+
+        if (seg_count == STATUS_HISTORY_CHECKPOINTS) {
+                seg_tail = (seg_tail + 1u) % STATUS_HISTORY_CHECKPOINTS;
+                --seg_count;
+        }
+        s = seg_at(seg_count);
+        ++seg_count;
+
+        s->time = now;
+        s->n_deltas = 0u;
+        memcpy(s->banks, next, sizeof(s->banks));
+}
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+void
+status_history_init(void)
+{
+        STATUS_ENTER_CRITICAL();
+        seg_tail = 0u;
+        seg_count = 0u;
+        last_time = 0u;
+        memset(cur, 0, sizeof(cur));
+        STATUS_EXIT_CRITICAL();
+}
+
+size_t
+status_history_sample(status_time_t now)
+{
+        size_t changed = 0u;
+
+        /* cur is only written here, so it can be compared unlocked. */
+        status_snapshot(STATUS_CLASS_FAULT, next, NUM_STATUS_BANKS);
+        status_snapshot(STATUS_CLASS_WARNING, &next[NUM_STATUS_BANKS],
+                        NUM_STATUS_BANKS);
+        status_snapshot(STATUS_CLASS_INFO, &next[2u * NUM_STATUS_BANKS],
+                        NUM_STATUS_BANKS);
+        for (size_t i = 0u; i < NUM_WORDS; ++i) {
+                if (next[i] != cur[i]) {
+                        ++changed;
+                }
+        }
+
+        STATUS_ENTER_CRITICAL();
+        if ((seg_count == 0u)
+            || ((seg_at(seg_count - 1u)->n_deltas + changed)
+                > STATUS_HISTORY_DELTAS)) {
+                checkpoint(now);
+        } else if (changed > 0u) {
+                struct history_segment *s = seg_at(seg_count - 1u);
+
+                for (size_t i = 0u; i < NUM_WORDS; ++i) {
+                        const uint16_t flip = (uint16_t)(next[i] ^ cur[i]);
+
+                        if (flip != 0u) {
+                                struct history_delta *d =
+                                    &s->deltas[s->n_deltas++];
+
+                                d->time = now;
+                                d->word = (uint16_t)i;
+                                d->flip = flip;
+                        }
+                }
+        } else {
+                /* Nothing changed: only the covered span grows. */
+        }
+        memcpy(cur, next, sizeof(cur));
+        last_time = now;
+        STATUS_EXIT_CRITICAL();
+
+        return changed;
+}
+
+bool
+status_history_at(status_time_t t, enum status_class cls, uint16_t *dst)
+{
+        bool found = false;
+
+        if ((dst == NULL)
+            || ((cls != STATUS_CLASS_FAULT) && (cls != STATUS_CLASS_WARNING)
+                && (cls != STATUS_CLASS_INFO))) {
+                return false;
+        }
+
+        const size_t first = (size_t)cls * NUM_STATUS_BANKS;
+
+        STATUS_ENTER_READ();
+        if ((seg_count > 0u) && !time_before(t, seg_at(0u)->time)) {
+                found = true;
+                if (!time_before(t, last_time)) {
+                        memcpy(dst, &cur[first],
+                               NUM_STATUS_BANKS * sizeof(dst[0]));
+                } else {
+                        const struct history_segment *s = seg_find(t);
+                        const uint32_t rt = (uint32_t)(t - s->time);
+
+                        memcpy(dst, &s->banks[first],
+                               NUM_STATUS_BANKS * sizeof(dst[0]));
+                        for (size_t i = 0u; i < s->n_deltas; ++i) {
+                                const struct history_delta *d = &s->deltas[i];
+                                const size_t bank = (size_t)d->word - first;
+
+                                if ((uint32_t)(d->time - s->time) > rt) {
+                                        break;
+                                }
+                                if (bank < NUM_STATUS_BANKS) {
+                                        dst[bank] ^= d->flip;
+                                }
+                        }
+                }
+        }
+        STATUS_EXIT_READ();
+
+        return found;
+}
+
+bool
+status_history_span(status_time_t *first, status_time_t *last)
+{
+        bool found = false;
+
+        STATUS_ENTER_READ();
+        if (seg_count > 0u) {
+                found = true;
+                if (first != NULL) {
+                        *first = seg_at(0u)->time;
+                }
+                if (last != NULL) {
+                        *last = last_time;
+                }
+        }
+        STATUS_EXIT_READ();
+
+        return found;
+}
@@ -0,0 +1,78 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_names.c
+ *
+ * @brief Perfect-hash name lookup over the generated status name tables.
+ */
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "status.h"
+#include "status_names.h"
+
+/* ================ DEFINES ================================================= */
+
+#define ID_PREFIX     "STATUS_ID_"
+#define ID_PREFIX_LEN (sizeof(ID_PREFIX) - 1u)
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+bool
+status_name_to_id(const char *name, size_t len, enum status_class *cls,
+                  uint16_t *id)
+{
+        const struct status_name_map *t = &status_name_table;
+        bool found = false;
+
+        if ((name != NULL) && (t->count > 0u)) {
+                if ((len > ID_PREFIX_LEN)
+                    && (memcmp(name, ID_PREFIX, ID_PREFIX_LEN) == 0)) {
+                        name += ID_PREFIX_LEN;
+                        len -= ID_PREFIX_LEN;
+                }
+
+                uint32_t b = (uint32_t)(status_name_hash(name, len, 0u)
+                                        % t->buckets);
+                uint32_t s = (uint32_t)(status_name_hash(name, len, t->disp[b])
+                                        % t->count);
+                const struct status_name_entry *e = &t->slots[s];
+
+                /*
+                 * A perfect hash maps unknown names somewhere too. Compare
+                 * lengths first: `name` may hold a NUL before `len`.
+                 */
+                if ((strlen(e->name) == len)
+                    && (memcmp(e->name, name, len) == 0)) {
+                        if (cls != NULL) {
+                                *cls = (enum status_class)e->cls;
+                        }
+                        if (id != NULL) {
+                                *id = e->id;
+                        }
+                        found = true;
+                }
+        }
+
+        return found;
+}
+
+const char *
+status_id_to_name(enum status_class cls, uint16_t id)
+{
+        const struct status_name_map *t = &status_name_table;
+        const char *name = NULL;
+
+        if (((cls == STATUS_CLASS_FAULT) || (cls == STATUS_CLASS_WARNING)
+             || (cls == STATUS_CLASS_INFO))
+            && (id < t->names_len)) {
+                name = t->names[cls][id];
+        }
+
+        return name;
+}
@@ -0,0 +1,410 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_persist.c
+ *
+ * @brief Append-only NVM log of changed banks.
+ */
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "status.h"
+#include "status_persist.h"
+#include "status_record.h"
+
+/* ================ DEFINES ================================================= */
+
+#if !STATUS_ENABLE_DIRTY
+#error "status_persist.c requires STATUS_ENABLE_DIRTY"
+#endif
+
+#define NUM_CLASSES (3u)
+#define NUM_WORDS   ((size_t)NUM_CLASSES * NUM_STATUS_BANKS)
+#define REC         STATUS_PERSIST_REC_SIZE
+
+/* Header: magic(2) num_banks(2) seq(2) crc16(2). */
+#define HDR_MAGIC (0x5350u)
+
+/* Record class byte of the commit record; its value field is the seq. */
+#define REC_COMMIT (0xC3u)
+
+/* Records fetched per read while scanning. */
+#define SCAN_CHUNK (32u)
+
+/* ================ STATIC VARIABLES ======================================== */
+
+static struct status_persist_cfg cfg;
+static bool opened;
+
+static uint8_t active;  /* area holding the current log */
+static uint16_t seq;    /* generation of the active area */
+static uint32_t head;   /* next free offset in the active area */
+
+/* The active area is full, torn or failed: compact before appending. */
+static bool need_compact;
+static bool compacting;
+static size_t compact_pos;    /* next word of `stage` to copy */
+static uint32_t compact_head; /* next free offset in the other area */
+
+/* The device failed during the latest step. */
+static bool io_failed;
+
+/* Banks being restored or compacted, as cls * NUM_STATUS_BANKS + bank. */
+static uint16_t stage[NUM_WORDS];
+
+/* ================ STATIC FUNCTIONS ======================================== */
+
+/* CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF). */
+static uint16_t
+crc16(const uint8_t *p, size_t n)
+{
+        uint16_t crc = 0xFFFFu;
+
+        for (size_t i = 0u; i < n; ++i) {
+                crc ^= (uint16_t)((uint16_t)p[i] << 8u);
+                for (unsigned int k = 0u; k < 8u; ++k) {
+                        crc = ((crc & 0x8000u) != 0u)
+                                  ? (uint16_t)((crc << 1u) ^ 0x1021u)
+                                  : (uint16_t)(crc << 1u);
+                }
+        }
+
+        return crc;
+}
+
+/* True if `a` is a newer generation than `b` (serial number arithmetic). */
+static inline bool
+seq_newer(uint16_t a, uint16_t b)
+{
+        return (int16_t)(uint16_t)(a - b) > 0;
+}
+
+static bool
+put(uint8_t area, uint32_t off, uint8_t b0, uint16_t w1, uint16_t w2)
+{
+        uint8_t r[REC];
+
+        r[0] = b0;
+        r[1] = 0u;
+        status_le16_put(&r[2], w1);
+        status_le16_put(&r[4], w2);
+        status_le16_put(&r[6], crc16(r, REC - 2u));
+
+        return cfg.write(cfg.ctx, area, off, r, REC);
+}
+
+static bool
+put_header(uint8_t area, uint16_t s)
+{
+        uint8_t r[REC];
+
+        status_le16_put(r, HDR_MAGIC);
+        status_le16_put(&r[2], (uint16_t)NUM_STATUS_BANKS);
+        status_le16_put(&r[4], s);
+        status_le16_put(&r[6], crc16(r, REC - 2u));
+
+        return cfg.write(cfg.ctx, area, 0u, r, REC);
+}
+
+/*
+ * Generation of an area with a valid header for this build. `valid` is
+ * false for a blank or foreign header; false is returned only if the
+ * device could not be read.
+ */
+static bool
+get_header(uint8_t area, uint16_t *s, bool *valid)
+{
+        uint8_t r[REC];
+
+        *valid = false;
+        if (!cfg.read(cfg.ctx, area, 0u, r, REC)) {
+                return false;
+        }
+        if ((status_le16_get(r) == HDR_MAGIC)
+            && (status_le16_get(&r[2]) == (uint16_t)NUM_STATUS_BANKS)
+            && (status_le16_get(&r[6]) == crc16(r, REC - 2u))) {
+                *s = status_le16_get(&r[4]);
+                *valid = true;
+        }
+
+        return true;
+}
+
+static bool
+is_erased(const uint8_t *r)
+{
+        for (size_t i = 0u; i < REC; ++i) {
+                if (r[i] != 0xFFu) {
+                        return false;
+                }
+        }
+
+        return true;
+}
+
+/*
+ * One sequential pass over an area into `stage`. Returns true if the
+ * snapshot was committed; `end` is the offset of the first record not
+ * applied and `torn` tells whether it is anything but erased. A read
+ * error also sets io_failed.
+ */
+static bool
+scan(uint8_t area, uint16_t s, uint32_t *end, bool *torn)
+{
+        uint8_t buf[SCAN_CHUNK * REC];
+        uint32_t off = REC;
+        bool committed = false;
+        bool stop = false;
+
+        memset(stage, 0, sizeof(stage));
+        *torn = false;
+
+        while (!stop && ((cfg.area_size - off) >= REC)) {
+                const uint32_t left = (cfg.area_size - off) / REC;
+                const size_t n = (left < SCAN_CHUNK) ? left : SCAN_CHUNK;
+
+                if (!cfg.read(cfg.ctx, area, off, buf, n * REC)) {
+                        io_failed = true;
+                        *torn = true;
+                        break;
+                }
+                for (size_t i = 0u; i < n; ++i) {
+                        const uint8_t *r = &buf[i * REC];
+                        const uint16_t bank = status_le16_get(&r[2]);
+                        const uint16_t value = status_le16_get(&r[4]);
+
+                        if (is_erased(r)) {
+                                stop = true;
+                        } else if ((r[1] != 0u)
+                                   || (status_le16_get(&r[6])
+                                       != crc16(r, REC - 2u))) {
+                                *torn = true;
+                        } else if (r[0] == REC_COMMIT) {
+                                *torn = committed || (value != s);
+                                committed = !*torn;
+                        } else if ((r[0] >= NUM_CLASSES)
+                                   || (bank >= NUM_STATUS_BANKS)) {
+                                *torn = true;
+                        } else {
+                                stage[((size_t)r[0] * NUM_STATUS_BANKS)
+                                      + bank] = value;
+                        }
+                        if (stop || *torn) {
+                                stop = true;
+                                break;
+                        }
+                        off += REC;
+                }
+        }
+        *end = off;
+
+        return committed;
+}
+
+/* Erase the other area and start a snapshot of the current register. */
+static void
+compact_begin(void)
+{
+        const uint8_t other = (uint8_t)(active ^ 1u);
+
+        if (!cfg.erase(cfg.ctx, other)
+            || !put_header(other, (uint16_t)(seq + 1u))) {
+                io_failed = true;
+                return;
+        }
+        /* Banks written from here on are marked again and appended later. */
+        status_dirty_clear();
+        status_snapshot(STATUS_CLASS_FAULT, stage, NUM_STATUS_BANKS);
+        status_snapshot(STATUS_CLASS_WARNING, &stage[NUM_STATUS_BANKS],
+                        NUM_STATUS_BANKS);
+        status_snapshot(STATUS_CLASS_INFO, &stage[2u * NUM_STATUS_BANKS],
+                        NUM_STATUS_BANKS);
+        compact_pos = 0u;
+        compact_head = REC;
+        compacting = true;
+}
+
+/* Copy up to `budget` banks of the snapshot; commit after the last one. */
+static size_t
+compact_run(size_t budget)
+{
+        const uint8_t other = (uint8_t)(active ^ 1u);
+        size_t done = 0u;
+
+        for (; (done < budget) && (compact_pos < NUM_WORDS); ++done) {
+                const uint16_t v = stage[compact_pos];
+
+                if (v != 0u) {
+                        if (!put(other, compact_head,
+                                 (uint8_t)(compact_pos / NUM_STATUS_BANKS),
+                                 (uint16_t)(compact_pos % NUM_STATUS_BANKS),
+                                 v)) {
+                                io_failed = true;
+                                compacting = false;
+                                return done;
+                        }
+                        compact_head += REC;
+                }
+                ++compact_pos;
+        }
+
+        if (compact_pos == NUM_WORDS) {
+                if (!put(other, compact_head, REC_COMMIT, 0u,
+                         (uint16_t)(seq + 1u))) {
+                        io_failed = true;
+                } else {
+                        active = other;
+                        ++seq;
+                        head = compact_head + REC;
+                        need_compact = false;
+                }
+                compacting = false;
+        }
+
+        return done;
+}
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+bool
+status_persist_open(const struct status_persist_cfg *cfg_in)
+{
+        uint16_t s[2] = {0u, 0u};
+        bool valid[2];
+        bool restored = false;
+
+        opened = false;
+        if ((cfg_in == NULL) || (cfg_in->read == NULL)
+            || (cfg_in->write == NULL) || (cfg_in->erase == NULL)
+            || (cfg_in->compact_at <= STATUS_PERSIST_SNAPSHOT_MAX)
+            || (cfg_in->compact_at > cfg_in->area_size)) {
+                return false;
+        }
+        cfg = *cfg_in;
+        compacting = false;
+        io_failed = false;
+
+        /* Never format storage that could not be read. */
+        if (!get_header(0u, &s[0], &valid[0])
+            || !get_header(1u, &s[1], &valid[1])) {
+                return false;
+        }
+
+        /* Newest first; fall back to the other if it was never committed. */
+        const uint8_t first = (valid[1] && (!valid[0] || seq_newer(s[1], s[0])))
+                                  ? 1u
+                                  : 0u;
+
+        for (uint8_t k = 0u; (k < 2u) && !restored; ++k) {
+                const uint8_t area = (uint8_t)(first ^ k);
+                bool torn = false;
+
+                if (valid[area] && scan(area, s[area], &head, &torn)) {
+                        active = area;
+                        seq = s[area];
+                        need_compact = torn;
+                        restored = true;
+                }
+        }
+        if (io_failed) {
+                return false;
+        }
+
+        if (restored) {
+                for (size_t i = 0u; i < NUM_WORDS; ++i) {
+                        status_field_set(
+                            (enum status_class)(i / NUM_STATUS_BANKS),
+                            STATUS_FIELD(i % NUM_STATUS_BANKS, 0u, 16u),
+                            stage[i]);
+                }
+        } else {
+                /* Blank or foreign storage: an empty snapshot in area 0. */
+                active = 0u;
+                seq = 1u;
+                head = 2u * REC;
+                need_compact = false;
+                if (!cfg.erase(cfg.ctx, 0u) || !put_header(0u, seq)
+                    || !put(0u, REC, REC_COMMIT, 0u, seq)) {
+                        return false;
+                }
+        }
+        status_dirty_clear();
+        opened = true;
+
+        return true;
+}
+
+size_t
+status_persist_step(size_t budget)
+{
+        size_t done = 0u;
+
+        if (!opened) {
+                return 0u;
+        }
+        io_failed = false;
+
+        if (!compacting && need_compact) {
+                compact_begin();
+        }
+        if (compacting) {
+                return compact_run(budget);
+        }
+        if (io_failed) {
+                return 0u;
+        }
+
+        while (done < budget) {
+                enum status_class c;
+                uint16_t bank;
+                uint16_t value;
+
+                if ((cfg.area_size - head) < REC) {
+                        need_compact = true;
+                        break;
+                }
+                if (!status_dirty_next(&c, &bank, &value)) {
+                        break;
+                }
+                if (!put(active, head, (uint8_t)c, bank, value)) {
+                        /* The bank is in the snapshot compaction takes. */
+                        need_compact = true;
+                        break;
+                }
+                head += REC;
+                ++done;
+        }
+        if (head >= cfg.compact_at) {
+                need_compact = true;
+        }
+
+        return done;
+}
+
+bool
+status_persist_sync(void)
+{
+        if (!opened) {
+                return false;
+        }
+
+        while ((status_persist_step(SIZE_MAX) > 0u) || compacting
+               || need_compact) {
+                if (io_failed) {
+                        return false;
+                }
+        }
+
+        return !io_failed;
+}
+
+uint32_t
+status_persist_used(void)
+{
+        return opened ? head : 0u;
+}
@@ -0,0 +1,122 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_replay.c
+ *
+ * @brief Recording replay through the public register API.
+ */
+
+/* ================ INCLUDES ================================================ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "status.h"
+#include "status_record.h"
+#include "status_replay.h"
+
+/* ================ STATIC FUNCTIONS ======================================== */
+
+static bool
+apply(const struct status_record *r)
+{
+        bool ok = true;
+
+        /* Caught here, not by the API, so it counts as invalid. */
+        if (((r->op == STATUS_REC_SET) || (r->op == STATUS_REC_CLEAR))
+            && (status_bank(r->id) >= NUM_STATUS_BANKS)) {
+                return false;
+        }
+
+        switch (r->op) {
+        case STATUS_REC_SET:
+                switch (r->cls) {
+                case STATUS_CLASS_FAULT: status_set_fault(r->id); break;
+                case STATUS_CLASS_WARNING: status_set_warning(r->id); break;
+                case STATUS_CLASS_INFO: status_set_info(r->id); break;
+                default: ok = false; break;
+                }
+                break;
+        case STATUS_REC_CLEAR:
+                switch (r->cls) {
+                case STATUS_CLASS_FAULT: status_clear_fault(r->id); break;
+                case STATUS_CLASS_WARNING: status_clear_warning(r->id); break;
+                case STATUS_CLASS_INFO: status_clear_info(r->id); break;
+                default: ok = false; break;
+                }
+                break;
+        case STATUS_REC_CLEAR_ALL:
+                ok = (r->cls <= (uint8_t)STATUS_CLASS_INFO);
+                if (ok) {
+                        status_clear_all((enum status_class)r->cls);
+                }
+                break;
+        default: ok = false; break;
+        }
+
+        return ok;
+}
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+uint32_t
+status_replay_checkpoint(void)
+{
+        uint16_t banks[NUM_STATUS_BANKS];
+        uint32_t h = STATUS_REC_HASH_INIT;
+
+        for (uint8_t c = 0u; c <= (uint8_t)STATUS_CLASS_INFO; ++c) {
+                status_snapshot((enum status_class)c, banks, NUM_STATUS_BANKS);
+                h = status_record_hash(banks, NUM_STATUS_BANKS, h);
+        }
+
+        return h;
+}
+
+bool
+status_replay(const uint8_t *rec, size_t len, status_replay_wait_fn wait,
+              void *ctx, struct status_replay_result *res)
+{
+        if ((rec == NULL) || (res == NULL) || (len < STATUS_REC_HDR_SIZE)
+            || (status_le32_get(rec) != STATUS_REC_MAGIC)
+            || (status_le16_get(&rec[4]) != STATUS_REC_VERSION)
+            || (status_le16_get(&rec[6]) != NUM_STATUS_BANKS)
+            || (status_le32_get(&rec[8]) != STATUS_REC_SIZE)) {
+                return false;
+        }
+
+        res->events = 0u;
+        res->invalid = 0u;
+        res->checkpoints = 0u;
+        res->mismatches = 0u;
+        res->first_mismatch = SIZE_MAX;
+
+        status_time_t prev = 0u;
+
+        for (size_t off = STATUS_REC_HDR_SIZE; (len - off) >= STATUS_REC_SIZE;
+             off += STATUS_REC_SIZE) {
+                struct status_record r;
+
+                status_record_unpack(&r, &rec[off]);
+                if (wait != NULL) {
+                        wait((res->events == 0u) ? 0u : (r.time - prev), ctx);
+                }
+                prev = r.time;
+
+                if (r.op == STATUS_REC_CHECKPOINT) {
+                        ++res->checkpoints;
+                        if (status_replay_checkpoint() != r.value) {
+                                if (res->mismatches == 0u) {
+                                        res->first_mismatch = res->events;
+                                }
+                                ++res->mismatches;
+                        }
+                } else if (!apply(&r)) {
+                        ++res->invalid;
+                }
+                ++res->events;
+        }
+
+        return true;
+}
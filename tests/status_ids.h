@@ -65,4 +65,35 @@
 // Bank 2: Communication Info
 #define STATUS_ID_INFO_CAN_ACTIVE      STATUS_ENCODE(2u, 0u)
 
+/* ----------------------
+ * Metadata (optional, STATUS_ENABLE_META)
+ * ----------------------
+ *
+ * X(id, rank, severity, group, flags, debounce) — expand with
+ * STATUS_META_ENTRY inside status_meta_table (see status_ids_meta.c).
+ */
+
+#define STATUS_FAULT_META(X)                                                   \
+        X(STATUS_ID_FAULT_OVERCURRENT,    250u, 3u, 1u, 0u, 0u)                \
+        X(STATUS_ID_FAULT_OVERVOLTAGE,    240u, 3u, 1u, 0u, 0u)                \
+        X(STATUS_ID_FAULT_UNDERVOLTAGE,   230u, 2u, 1u, 0u, 0u)                \
+        X(STATUS_ID_FAULT_DC_BUS_FAULT,   220u, 3u, 1u, 0u, 0u)                \
+        X(STATUS_ID_FAULT_OVER_TEMP_AFE,  150u, 2u, 2u, 0u, 0u)                \
+        X(STATUS_ID_FAULT_OVER_TEMP_INV,  140u, 2u, 2u, 0u, 0u)                \
+        X(STATUS_ID_FAULT_CAN_TIMEOUT,    100u, 1u, 3u, 0u, 0u)                \
+        X(STATUS_ID_FAULT_MODULE_MISSING,  90u, 1u, 3u, 0u, 0u)
+
+#define STATUS_WARN_META(X)                                                    \
+        X(STATUS_ID_WARN_VOLTAGE_FLUCT,    50u, 1u, 1u, 0u, 0u)                \
+        X(STATUS_ID_WARN_CURRENT_NOISE,    40u, 1u, 1u, 0u, 0u)                \
+        X(STATUS_ID_WARN_TEMP_NEAR_LIMIT,  30u, 1u, 2u, 0u, 0u)                \
+        X(STATUS_ID_WARN_FAN_PERF_DROP,    20u, 1u, 2u, 0u, 0u)                \
+        X(STATUS_ID_WARN_CAN_LOAD_HIGH,    10u, 1u, 3u, 0u, 0u)                \
+        X(STATUS_ID_WARN_BROADCAST_LOSS,    5u, 1u, 3u, 0u, 0u)
+
+#define STATUS_INFO_META(X)                                                    \
+        X(STATUS_ID_INFO_AC_LIVE,        STATUS_PRIO_NONE, 0u, 1u, 0u, 0u)     \
+        X(STATUS_ID_INFO_TEMP_CHANGING,  STATUS_PRIO_NONE, 0u, 2u, 0u, 0u)     \
+        X(STATUS_ID_INFO_CAN_ACTIVE,     STATUS_PRIO_NONE, 0u, 3u, 0u, 0u)
+
 #endif // STATUS_IDS_H
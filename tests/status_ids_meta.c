@@ -0,0 +1,13 @@
+/*
+ * @file: status_ids_meta.c (example)
+ * @brief Example metadata table built from the lists in status_ids.h.
+ */
+
+#include "status.h"
+#include "status_ids.h"
+
+const struct status_meta status_meta_table[3][STATUS_META_LEN] = {
+        [STATUS_CLASS_FAULT] = {STATUS_FAULT_META(STATUS_META_ENTRY)},
+        [STATUS_CLASS_WARNING] = {STATUS_WARN_META(STATUS_META_ENTRY)},
+        [STATUS_CLASS_INFO] = {STATUS_INFO_META(STATUS_META_ENTRY)},
+};
@@ -0,0 +1,10 @@
+/*
+ * @file: status_test_config.c
+ * @brief Storage for the hooks declared in status_test_config.h.
+ */
+
+#include <stdint.h>
+
+#include "status_test_config.h"
+
+volatile uint32_t status_test_clock;
@@ -0,0 +1,21 @@
+/*
+ * @file: status_test_config.h
+ * @brief Platform hooks for tests that compile the library with optional
+ *        features enabled. Force-included ahead of every source file.
+ */
+
+#ifndef STATUS_TEST_CONFIG_H
+#define STATUS_TEST_CONFIG_H
+
+#include <stdint.h>
+
+/* Manually advanced clock, defined by the test. */
+extern volatile uint32_t status_test_clock;
+
+/* No-op critical sections for host-side testing. */
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#define STATUS_TIME_NOW() (status_test_clock)
+
+#endif /* STATUS_TEST_CONFIG_H */
@@ -0,0 +1,30 @@
+/*
+ * @file: test_harness.h
+ * @brief Minimal assertion helpers shared by the host unit tests.
+ */
+
+#ifndef TEST_HARNESS_H
+#define TEST_HARNESS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ------------------------------------------------------------------ */
+/* Test infrastructure                                                  */
+/* ------------------------------------------------------------------ */
+
+/*
+ * TEST_ASSERT always fires regardless of NDEBUG, unlike <assert.h>.
+ */
+#define TEST_ASSERT(expr)                                                      \
+        do {                                                                   \
+                if (!(expr)) {                                                 \
+                        fprintf(stderr, "FAIL  %s:%d  %s\n", __FILE__,         \
+                                __LINE__, #expr);                              \
+                        exit(EXIT_FAILURE);                                    \
+                }                                                              \
+        } while (0)
+
+#define TEST_PASS(name) fprintf(stdout, "PASS  %s\n", (name))
+
+#endif /* TEST_HARNESS_H */
@@ -15,24 +15,7 @@
 
 #include "status.h"
 #include "status_ids.h"
-
-/* ------------------------------------------------------------------ */
-/* Test infrastructure                                                  */
-/* ------------------------------------------------------------------ */
-
-/*
- * TEST_ASSERT always fires regardless of NDEBUG, unlike <assert.h>.
- */
-#define TEST_ASSERT(expr)                                                      \
-        do {                                                                   \
-                if (!(expr)) {                                                 \
-                        fprintf(stderr, "FAIL  %s:%d  %s\n", __FILE__,         \
-                                __LINE__, #expr);                              \
-                        exit(EXIT_FAILURE);                                    \
-                }                                                              \
-        } while (0)
-
-#define TEST_PASS(name) fprintf(stdout, "PASS  %s\n", (name))
+#include "test_harness.h"
 
 /* ------------------------------------------------------------------ */
 /* Error-callback fixture                                               */
@@ -63,6 +46,7 @@ setUp(void)
 {
         status_init();
         status_set_err_callback(test_err_cb);
+        status_set_err_rate_limit(1u);
         reset_err_state();
 }
 
@@ -661,6 +645,342 @@ test_last_id_most_recent_wins(void)
         TEST_PASS(__func__);
 }
 
+/*
+ * Every error is counted per kind with its first and last offending ID;
+ * status_init() clears the counters.
+ */
+static void
+test_err_stats_counts(void)
+{
+        setUp();
+
+        struct status_err_stats st[STATUS_ERR_NUM];
+        const uint16_t bad1 = STATUS_ENCODE((uint16_t)NUM_STATUS_BANKS, 0u);
+        const uint16_t bad2 = STATUS_ENCODE((uint16_t)NUM_STATUS_BANKS, 7u);
+
+        status_set_fault(bad1);
+        status_clear_warning(bad2);
+        status_set_info(bad2);
+        status_snapshot(STATUS_CLASS_FAULT, NULL, 1u);
+
+        status_err_stats(st, STATUS_ERR_NUM);
+        TEST_ASSERT(st[STATUS_ERR_INVALID_BANK].count == 3u);
+        TEST_ASSERT(st[STATUS_ERR_INVALID_BANK].first_id == bad1);
+        TEST_ASSERT(st[STATUS_ERR_INVALID_BANK].last_id == bad2);
+        TEST_ASSERT(st[STATUS_ERR_NULL_PTR].count == 1u);
+        TEST_ASSERT(st[STATUS_ERR_NULL_PTR].first_id == STATUS_UNSET_ID);
+        TEST_ASSERT(st[STATUS_ERR_INVALID_ID].count == 0u);
+        TEST_ASSERT(g_err_count == 4u);
+
+        /* A short destination is filled up to its length. */
+        st[1].count = 0xDEADu;
+        status_err_stats(st, 1u);
+        TEST_ASSERT(st[1].count == 0xDEADu);
+
+        status_init();
+        status_err_stats(st, STATUS_ERR_NUM);
+        TEST_ASSERT(st[STATUS_ERR_INVALID_BANK].count == 0u);
+        TEST_ASSERT(st[STATUS_ERR_NULL_PTR].count == 0u);
+
+        status_err_stats(NULL, STATUS_ERR_NUM);
+        TEST_ASSERT(g_last_err == STATUS_ERR_NULL_PTR);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * With a rate limit of N, only every Nth occurrence of each error reaches
+ * the callback, while all of them are counted.
+ */
+static void
+test_err_rate_limit(void)
+{
+        setUp();
+
+        struct status_err_stats st[STATUS_ERR_NUM];
+        const uint16_t bad = STATUS_ENCODE((uint16_t)NUM_STATUS_BANKS, 1u);
+
+        status_set_err_rate_limit(100u);
+        for (unsigned int i = 0u; i < 1000u; ++i) {
+                status_set_fault(bad);
+        }
+        TEST_ASSERT(g_err_count == 10u);
+
+        /* Kinds are coalesced independently. */
+        status_snapshot(STATUS_CLASS_FAULT, NULL, 1u);
+        TEST_ASSERT(g_err_count == 11u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_NULL_PTR);
+
+        status_err_stats(st, STATUS_ERR_NUM);
+        TEST_ASSERT(st[STATUS_ERR_INVALID_BANK].count == 1000u);
+        TEST_ASSERT(st[STATUS_ERR_INVALID_BANK].last_id == bad);
+
+        status_set_err_rate_limit(0u);
+        reset_err_state();
+        status_set_fault(bad);
+        status_set_fault(bad);
+        TEST_ASSERT(g_err_count == 2u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Compiling an unordered ID list with duplicates yields sorted, merged
+ * terms; any/all/collect evaluate them against the current register.
+ */
+static void
+test_query_compile_and_eval(void)
+{
+        setUp();
+
+        const uint16_t ids[] = {
+                STATUS_ID_FAULT_CAN_TIMEOUT,   STATUS_ID_FAULT_OVERCURRENT,
+                STATUS_ID_FAULT_OVER_TEMP_AFE, STATUS_ID_FAULT_OVERVOLTAGE,
+                STATUS_ID_FAULT_CAN_TIMEOUT,
+        };
+        struct status_query_term q[4];
+        uint16_t hits[4];
+        const size_t n = status_query_compile(q, 4u, ids, 5u);
+
+        TEST_ASSERT(n == 3u);
+        TEST_ASSERT((q[0].bank == 0u) && (q[0].mask == 0x0003u));
+        TEST_ASSERT((q[1].bank == 1u) && (q[1].mask == 0x0001u));
+        TEST_ASSERT((q[2].bank == 2u) && (q[2].mask == 0x0001u));
+
+        TEST_ASSERT(!status_query_any(STATUS_CLASS_FAULT, q, n));
+        TEST_ASSERT(status_query_collect(STATUS_CLASS_FAULT, q, n, hits) == 0u);
+
+        status_set_fault(STATUS_ID_FAULT_UNDERVOLTAGE); /* not a member */
+        status_set_warning(STATUS_ID_FAULT_OVERCURRENT); /* other class */
+        TEST_ASSERT(!status_query_any(STATUS_CLASS_FAULT, q, n));
+
+        status_set_fault(STATUS_ID_FAULT_OVERVOLTAGE);
+        status_set_fault(STATUS_ID_FAULT_CAN_TIMEOUT);
+        TEST_ASSERT(status_query_any(STATUS_CLASS_FAULT, q, n));
+        TEST_ASSERT(!status_query_all(STATUS_CLASS_FAULT, q, n));
+        TEST_ASSERT(status_query_collect(STATUS_CLASS_FAULT, q, n, hits) == 2u);
+        TEST_ASSERT((hits[0] == 0x0002u) && (hits[1] == 0u)
+                    && (hits[2] == 0x0001u));
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_AFE);
+        TEST_ASSERT(status_query_all(STATUS_CLASS_FAULT, q, n));
+        TEST_ASSERT(status_query_all(STATUS_CLASS_FAULT, q, 0u));
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Bad arguments are reported and make the queries false / empty.
+ */
+static void
+test_query_errors(void)
+{
+        setUp();
+
+        const uint16_t ids[] = {
+                STATUS_ID_FAULT_OVERCURRENT,
+                STATUS_ID_FAULT_OVER_TEMP_AFE,
+        };
+        const uint16_t bad_id = STATUS_ENCODE((uint16_t)NUM_STATUS_BANKS, 0u);
+        const struct status_query_term bad[] = {
+                STATUS_QUERY_TERM(0u, 0x0001u),
+                STATUS_QUERY_TERM(NUM_STATUS_BANKS, 0x0001u),
+        };
+        struct status_query_term q[2];
+        uint16_t hits[2];
+
+        TEST_ASSERT(status_query_compile(q, 1u, ids, 2u) == 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_LEN);
+        TEST_ASSERT(status_query_compile(q, 2u, &bad_id, 1u) == 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        TEST_ASSERT(g_last_err_id == bad_id);
+        TEST_ASSERT(status_query_compile(NULL, 2u, ids, 2u) == 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_NULL_PTR);
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        reset_err_state();
+        TEST_ASSERT(!status_query_all(STATUS_CLASS_FAULT, bad, 2u));
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        TEST_ASSERT(status_query_collect(STATUS_CLASS_FAULT, bad, 2u, NULL)
+                    == 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_NULL_PTR);
+        TEST_ASSERT(!status_query_any((enum status_class)7, bad, 1u));
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ID);
+        TEST_ASSERT(status_query_collect(STATUS_CLASS_FAULT, bad, 1u, hits)
+                    == 1u);
+        TEST_ASSERT(g_err_count == 3u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * set_if / clear_unless read a condition in one class and update another;
+ * the update happens only when the predicate allows it.
+ */
+static void
+test_conditional_updates(void)
+{
+        setUp();
+
+        const struct status_query_term faults[] = {
+                STATUS_QUERY_TERM(0u, 0x0003u),
+        };
+        const struct status_query_term bad[] = {
+                STATUS_QUERY_TERM(NUM_STATUS_BANKS, 0x0001u),
+        };
+        const struct status_cond no_fault = {STATUS_CLASS_FAULT, faults, 1u,
+                                             STATUS_COND_NONE};
+        const struct status_cond any_fault = {STATUS_CLASS_FAULT, faults, 1u,
+                                              STATUS_COND_ANY};
+        const struct status_cond all_fault = {STATUS_CLASS_FAULT, faults, 1u,
+                                              STATUS_COND_ALL};
+        const struct status_cond bad_cond = {STATUS_CLASS_FAULT, bad, 1u,
+                                             STATUS_COND_ANY};
+
+        /* "Ready" may only be raised while no fault of the group is active. */
+        TEST_ASSERT(status_set_if(STATUS_CLASS_INFO, 0x0010u, &no_fault));
+        TEST_ASSERT(status_is_info_set(0x0010u));
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_clear_info(0x0010u);
+        TEST_ASSERT(!status_set_if(STATUS_CLASS_INFO, 0x0010u, &no_fault));
+        TEST_ASSERT(!status_is_info_set(0x0010u));
+        TEST_ASSERT(status_last_info() == 0x0010u);
+
+        /* A warning is kept while the group is (fully) faulted. */
+        status_set_warning(0x0021u);
+        TEST_ASSERT(!status_clear_unless(STATUS_CLASS_WARNING, 0x0021u,
+                                         &any_fault));
+        TEST_ASSERT(status_is_warning_set(0x0021u));
+        status_set_fault(STATUS_ID_FAULT_OVERVOLTAGE);
+        TEST_ASSERT(!status_clear_unless(STATUS_CLASS_WARNING, 0x0021u,
+                                         &all_fault));
+        TEST_ASSERT(status_is_warning_set(0x0021u));
+        status_clear_fault(STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(status_clear_unless(STATUS_CLASS_WARNING, 0x0021u,
+                                        &all_fault));
+        TEST_ASSERT(!status_is_warning_set(0x0021u));
+        TEST_ASSERT(g_err_count == 0u);
+
+        /* Errors write nothing and report false. */
+        TEST_ASSERT(!status_set_if(STATUS_CLASS_INFO, 0x0010u, NULL));
+        TEST_ASSERT(g_last_err == STATUS_ERR_NULL_PTR);
+        TEST_ASSERT(!status_set_if(STATUS_CLASS_INFO, 0x0010u, &bad_cond));
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        TEST_ASSERT(g_last_err_id == 0x0010u);
+        TEST_ASSERT(!status_clear_unless(STATUS_CLASS_FAULT,
+                                         STATUS_ID_FAULT_OVERVOLTAGE,
+                                         &bad_cond));
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERVOLTAGE));
+        TEST_ASSERT(!status_set_if((enum status_class)7, 0x0010u, &no_fault));
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ID);
+        TEST_ASSERT(!status_is_info_set(0x0010u));
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Fields are written and read as a whole and leave neighbouring bits
+ * alone; out-of-range values and fields are rejected.
+ */
+static void
+test_field_set_get(void)
+{
+        setUp();
+
+        const status_field_t sev = STATUS_FIELD(3u, 4u, 2u);
+        const status_field_t cnt = STATUS_FIELD(3u, 8u, 8u);
+
+        TEST_ASSERT(status_field_bank(cnt) == 3u);
+        TEST_ASSERT(status_field_shift(cnt) == 8u);
+        TEST_ASSERT(status_field_width(cnt) == 8u);
+
+        status_set_warning(STATUS_ENCODE(3u, 0u));
+        status_field_set(STATUS_CLASS_WARNING, sev, 2u);
+        status_field_set(STATUS_CLASS_WARNING, cnt, 0xA5u);
+        TEST_ASSERT(status_field_get(STATUS_CLASS_WARNING, sev) == 2u);
+        TEST_ASSERT(status_field_get(STATUS_CLASS_WARNING, cnt) == 0xA5u);
+        status_field_set(STATUS_CLASS_WARNING, sev, 1u);
+        TEST_ASSERT(status_field_get(STATUS_CLASS_WARNING, sev) == 1u);
+        TEST_ASSERT(status_field_get(STATUS_CLASS_WARNING, cnt) == 0xA5u);
+        TEST_ASSERT(status_is_warning_set(STATUS_ENCODE(3u, 0u)));
+        TEST_ASSERT(status_is_warning_set(STATUS_ENCODE(3u, 4u)));
+        TEST_ASSERT(!status_is_warning_set(STATUS_ENCODE(3u, 5u)));
+        TEST_ASSERT(status_field_get(STATUS_CLASS_FAULT, sev) == 0u);
+        TEST_ASSERT(g_err_count == 0u);
+
+        status_field_set(STATUS_CLASS_WARNING, sev, 4u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+        TEST_ASSERT(g_last_err_id == STATUS_ENCODE(3u, 4u));
+        TEST_ASSERT(status_field_get(STATUS_CLASS_WARNING, sev) == 1u);
+        status_field_set(STATUS_CLASS_WARNING, STATUS_FIELD(3u, 12u, 8u), 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+        TEST_ASSERT(status_field_get(STATUS_CLASS_WARNING, cnt) == 0xA5u);
+        TEST_ASSERT(status_field_get(STATUS_CLASS_WARNING,
+                                     STATUS_FIELD(NUM_STATUS_BANKS, 0u, 4u))
+                    == 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        status_field_set((enum status_class)5, sev, 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ID);
+        TEST_ASSERT(g_err_count == 4u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * The word-wise "at or above" scan agrees with a field-by-field count for
+ * every width and threshold.
+ */
+static void
+test_field_count_at_least(void)
+{
+        setUp();
+
+        const status_field_t whole = STATUS_FIELD(1u, 0u, 16u);
+
+        for (uint32_t x = 0u; x <= 0xFFFFu; x += 251u) {
+                status_field_set(STATUS_CLASS_INFO, whole, (uint16_t)x);
+                for (uint16_t w = 1u; w <= 16u; w = (uint16_t)(w * 2u)) {
+                        const uint32_t max = (1u << w) - 1u;
+                        const uint32_t step = (w == 16u) ? 4099u : 1u;
+
+                        for (uint32_t lvl = 0u; lvl <= max + 1u; lvl += step) {
+                                size_t want = 0u;
+
+                                for (uint32_t sh = 0u; sh < 16u; sh += w) {
+                                        want += ((x >> sh) & max) >= lvl;
+                                }
+                                TEST_ASSERT(status_field_count_at_least(
+                                                STATUS_CLASS_INFO, 1u, 1u, w,
+                                                (uint16_t)lvl)
+                                            == want);
+                        }
+                }
+        }
+
+        /* Severity map: eight 2-bit fields per bank over banks 4..5. */
+        const enum status_class f = STATUS_CLASS_FAULT;
+
+        status_clear_all(f);
+        status_field_set(f, STATUS_FIELD(4u, 2u, 2u), 1u);
+        status_field_set(f, STATUS_FIELD(5u, 14u, 2u), 3u);
+        TEST_ASSERT(status_field_any_at_least(f, 4u, 2u, 2u, 3u));
+        TEST_ASSERT(!status_field_any_at_least(f, 4u, 1u, 2u, 2u));
+        TEST_ASSERT(status_field_count_at_least(f, 4u, 2u, 2u, 1u) == 2u);
+        TEST_ASSERT(status_field_count_at_least(f, 4u, 2u, 2u, 0u) == 16u);
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_ASSERT(status_field_count_at_least(f, 4u, 2u, 3u, 1u) == 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+        TEST_ASSERT(
+            !status_field_any_at_least(f, 1u, NUM_STATUS_BANKS, 2u, 1u));
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+
+        TEST_PASS(__func__);
+}
+
 /* ------------------------------------------------------------------ */
 /* Main                                                                  */
 /* ------------------------------------------------------------------ */
@@ -704,6 +1024,13 @@ main(void)
         test_clear_fault_preserves_last_id();
         test_null_callback_deregisters();
         test_last_id_most_recent_wins();
+        test_err_stats_counts();
+        test_err_rate_limit();
+        test_query_compile_and_eval();
+        test_query_errors();
+        test_conditional_updates();
+        test_field_set_get();
+        test_field_count_at_least();
 
         fprintf(stdout, "\nAll tests passed.\n");
         return EXIT_SUCCESS;
@@ -0,0 +1,169 @@
+/*
+ * @file: test_status_alloc.c
+ * @brief Unit tests for the runtime bank allocator and owner checks.
+ *
+ * @note Built with STATUS_ENABLE_BANK_ALLOC=1, STATUS_ENABLE_BANK_OWNERS=1,
+ *       NUM_STATUS_BANKS=80 and STATUS_BANK_ALLOC_FIRST=8 (banks 0..7 hold
+ *       the compile-time IDs), plus status_test_config.h.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "status.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+#define MOD_A (1u)
+#define MOD_B (2u)
+
+static status_err_t g_last_err;
+static uint16_t g_last_err_id;
+static unsigned int g_err_count;
+
+static void
+test_err_cb(status_err_t err, uint16_t id)
+{
+        g_last_err = err;
+        g_last_err_id = id;
+        ++g_err_count;
+}
+
+static void
+setUp(void)
+{
+        status_init();
+        status_set_err_callback(test_err_cb);
+        status_set_err_rate_limit(1u);
+        g_err_count = 0u;
+}
+
+/*
+ * Ranges are handed out first fit above the static banks, reused after
+ * free, and may span bitmap words.
+ */
+static void
+test_alloc_first_fit(void)
+{
+        setUp();
+
+        const uint16_t a = status_bank_alloc(4u, MOD_A);
+        const uint16_t b = status_bank_alloc(40u, MOD_B);
+        const uint16_t c = status_bank_alloc(2u, MOD_A);
+
+        TEST_ASSERT(a == STATUS_BANK_ALLOC_FIRST);
+        TEST_ASSERT(b == (uint16_t)(a + 4u)); /* crosses bank 32 */
+        TEST_ASSERT(c == (uint16_t)(b + 40u));
+        TEST_ASSERT(status_bank_owner(a) == MOD_A);
+        TEST_ASSERT(status_bank_owner((uint16_t)(b + 39u)) == MOD_B);
+        TEST_ASSERT(status_bank_owner(0u) == STATUS_OWNER_NONE);
+
+        /* 80 - 54 = 26 banks left. */
+        TEST_ASSERT(status_bank_alloc(27u, MOD_A) == STATUS_BANK_NONE);
+
+        status_bank_free(a, 4u, MOD_A);
+        TEST_ASSERT(status_bank_owner(a) == STATUS_OWNER_NONE);
+        TEST_ASSERT(status_bank_alloc(5u, MOD_B) == (uint16_t)(c + 2u));
+        TEST_ASSERT(status_bank_alloc(3u, MOD_B) == a);
+        TEST_ASSERT(status_bank_alloc(1u, MOD_B) == (uint16_t)(a + 3u));
+        TEST_ASSERT(status_bank_alloc(21u, MOD_B) == (uint16_t)(c + 7u));
+        TEST_ASSERT(status_bank_alloc(1u, MOD_B) == STATUS_BANK_NONE);
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Owner-checked writes reach only the writer's own banks; releasing a
+ * range clears it in every class.
+ */
+static void
+test_owned_writes_and_release(void)
+{
+        setUp();
+
+        const uint16_t a = status_bank_alloc(2u, MOD_A);
+        const uint16_t b = status_bank_alloc(1u, MOD_B);
+        const uint16_t id_a = STATUS_ENCODE(a + 1u, 3u);
+        const uint16_t id_b = STATUS_ENCODE(b, 0u);
+
+        status_set_owned(STATUS_CLASS_FAULT, id_a, MOD_A);
+        status_set_owned(STATUS_CLASS_INFO, id_a, MOD_A);
+        TEST_ASSERT(status_is_fault_set(id_a) && status_is_info_set(id_a));
+        TEST_ASSERT(g_err_count == 0u);
+
+        /* Module A writing with a B bank by mistake. */
+        status_set_owned(STATUS_CLASS_FAULT, id_b, MOD_A);
+        TEST_ASSERT(!status_is_fault_set(id_b));
+        TEST_ASSERT(g_last_err == STATUS_ERR_NOT_OWNER);
+        TEST_ASSERT(g_last_err_id == id_b);
+        status_clear_owned(STATUS_CLASS_FAULT, id_a, MOD_B);
+        TEST_ASSERT(status_is_fault_set(id_a));
+        status_set_owned(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVERCURRENT,
+                         MOD_A);
+        TEST_ASSERT(g_last_err == STATUS_ERR_NOT_OWNER);
+        TEST_ASSERT(g_err_count == 3u);
+
+        status_clear_owned(STATUS_CLASS_INFO, id_a, MOD_A);
+        TEST_ASSERT(!status_is_info_set(id_a));
+
+        /* Unload module A. */
+        status_bank_free(a, 2u, MOD_A);
+        TEST_ASSERT(!status_is_fault_set(id_a));
+        TEST_ASSERT(!status_any(STATUS_CLASS_FAULT));
+        status_set_owned(STATUS_CLASS_FAULT, id_a, MOD_A);
+        TEST_ASSERT(!status_is_fault_set(id_a));
+        TEST_ASSERT(g_last_err == STATUS_ERR_NOT_OWNER);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Bad frees and allocations are reported and change nothing.
+ */
+static void
+test_invalid_requests(void)
+{
+        setUp();
+
+        const uint16_t a = status_bank_alloc(2u, MOD_A);
+
+        TEST_ASSERT(status_bank_alloc(0u, MOD_A) == STATUS_BANK_NONE);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_LEN);
+        TEST_ASSERT(status_bank_alloc(1u, STATUS_OWNER_NONE)
+                    == STATUS_BANK_NONE);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+
+        status_bank_free(a, 2u, MOD_B);
+        TEST_ASSERT(g_last_err == STATUS_ERR_NOT_OWNER);
+        TEST_ASSERT(g_last_err_id == STATUS_ENCODE(a, 0u));
+        status_bank_free(a, 3u, MOD_A); /* third bank is free */
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+        TEST_ASSERT(g_last_err_id == STATUS_ENCODE(a + 2u, 0u));
+        TEST_ASSERT(status_bank_owner(a) == MOD_A);
+        status_bank_free(0u, 1u, MOD_A); /* compile-time bank */
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        status_bank_free((uint16_t)(NUM_STATUS_BANKS - 1u), 2u, MOD_A);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        TEST_ASSERT(g_err_count == 6u);
+
+        status_bank_free(a, 2u, MOD_A);
+        TEST_ASSERT(status_bank_owner(a) == STATUS_OWNER_NONE);
+        TEST_ASSERT(g_err_count == 6u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_alloc_first_fit();
+        test_owned_writes_and_release();
+        test_invalid_requests();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
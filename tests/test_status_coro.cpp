@@ -0,0 +1,225 @@
+/*
+ * @file: test_status_coro.cpp
+ * @brief Unit tests for the status change awaitable.
+ */
+
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+#include "status_coro.hpp"
+#include "test_harness.h"
+
+using status::fault_id;
+using status::id_class;
+using status::warning_id;
+
+constexpr std::size_t banks = 4u;
+using reg_t =
+    status::status_register<banks, std::uint16_t, status::change_waiters<banks>>;
+
+/* Coroutine that starts eagerly and keeps its frame until destroyed. */
+struct task {
+        struct promise_type {
+                task
+                get_return_object()
+                {
+                        return task{std::coroutine_handle<promise_type>::from_promise(
+                            *this)};
+                }
+                std::suspend_never initial_suspend() noexcept { return {}; }
+                std::suspend_always final_suspend() noexcept { return {}; }
+                void return_void() noexcept {}
+                void unhandled_exception() { std::terminate(); }
+        };
+
+        explicit task(std::coroutine_handle<promise_type> h) : h(h) {}
+        task(task &&o) noexcept : h(o.h) { o.h = {}; }
+        ~task()
+        {
+                if (h) {
+                        h.destroy();
+                }
+        }
+
+        bool done() const { return h.done(); }
+
+        std::coroutine_handle<promise_type> h;
+};
+
+/* Executor that queues handles until run() is called. */
+struct queue_executor {
+        std::coroutine_handle<> q[8];
+        unsigned int n = 0u;
+
+        void post(std::coroutine_handle<> h) { q[n++] = h; }
+
+        void
+        run()
+        {
+                for (unsigned int i = 0u; i < n; ++i) {
+                        q[i].resume();
+                }
+                n = 0u;
+        }
+};
+
+static task
+wait_mask(reg_t &reg, id_class cls, std::size_t bank, std::uint16_t mask,
+          std::uint16_t *out)
+{
+        *out = co_await status::status_changed(reg, cls, bank, mask);
+}
+
+static task
+wait_overcurrent(reg_t &reg, queue_executor &ex, unsigned int *edges)
+{
+        for (;;) {
+                co_await status::status_changed<fault_id<1, 3>>(reg, ex);
+                ++*edges;
+        }
+}
+
+/*
+ * A waiter resumes on a matching set edge with the flipped bits, and not on
+ * writes to other bits, banks or classes.
+ */
+static void
+test_wakes_on_matching_edge(void)
+{
+        static reg_t reg;
+        std::uint16_t got = 0u;
+        task t = wait_mask(reg, id_class::fault, 2u, 0x00F0u, &got);
+
+        TEST_ASSERT(reg.observer().waiting() == 1u);
+        reg.set<fault_id<2, 0>>();
+        reg.set<fault_id<1, 4>>();
+        reg.set<warning_id<2, 4>>();
+        TEST_ASSERT(!t.done());
+
+        reg.set<fault_id<2, 5>>();
+        TEST_ASSERT(t.done());
+        TEST_ASSERT(got == 0x0020u);
+        TEST_ASSERT(reg.observer().waiting() == 0u);
+
+        /* Clearing an already clear bit is not an edge. */
+        task c = wait_mask(reg, id_class::fault, 2u, 0x0020u, &got);
+        reg.clear<fault_id<2, 6>>();
+        TEST_ASSERT(!c.done());
+        reg.clear_all(id_class::fault);
+        TEST_ASSERT(c.done());
+        TEST_ASSERT(got == 0x0020u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * With an executor, the wake-up is posted rather than run inline, and a
+ * looping waiter re-registers for every edge.
+ */
+static void
+test_executor_and_rearm(void)
+{
+        static reg_t reg;
+        queue_executor ex;
+        unsigned int edges = 0u;
+        task t = wait_overcurrent(reg, ex, &edges);
+
+        reg.set<fault_id<1, 3>>();
+        TEST_ASSERT(edges == 0u);
+        TEST_ASSERT(ex.n == 1u);
+        ex.run();
+        TEST_ASSERT(edges == 1u);
+
+        reg.set<fault_id<1, 3>>(); /* already set: no edge */
+        TEST_ASSERT(ex.n == 0u);
+        reg.clear<fault_id<1, 3>>();
+        ex.run();
+        TEST_ASSERT(edges == 2u);
+
+        TEST_PASS(__func__);
+}
+
+/* Another writer sets fault 0/2 between creating the awaiter and awaiting. */
+static task
+wait_after_racing_set(reg_t &reg, std::uint16_t *out)
+{
+        auto changed = status::status_changed<fault_id<0, 2>>(reg);
+
+        reg.set<fault_id<0, 2>>();
+        *out = co_await changed;
+}
+
+/*
+ * An edge between creating the awaiter and suspending is not lost: the
+ * coroutine does not suspend and gets the flipped bit.
+ */
+static void
+test_edge_before_suspend(void)
+{
+        static reg_t reg;
+        std::uint16_t got = 0u;
+        task t = wait_after_racing_set(reg, &got);
+
+        TEST_ASSERT(t.done());
+        TEST_ASSERT(got == 0x0004u);
+        TEST_ASSERT(reg.observer().waiting() == 0u);
+
+        /* Without a racing edge the coroutine suspends as before. */
+        task u = wait_mask(reg, id_class::fault, 0u, 0x0001u, &got);
+        TEST_ASSERT(!u.done());
+        reg.set<fault_id<0, 0>>();
+        TEST_ASSERT(u.done());
+        TEST_ASSERT(got == 0x0001u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Many waiters on one bank all resume from one write; destroying a
+ * suspended coroutine unlinks its waiter.
+ */
+static void
+test_many_waiters_and_cancel(void)
+{
+        static reg_t reg;
+        static std::uint16_t got[1000];
+        static task *tasks[1000];
+
+        for (unsigned int i = 0u; i < 1000u; ++i) {
+                tasks[i] = new task(wait_mask(reg, id_class::info, 3u,
+                                              (std::uint16_t)(1u << (i % 2u)),
+                                              &got[i]));
+        }
+        TEST_ASSERT(reg.observer().waiting() == 1000u);
+
+        delete tasks[0];
+        TEST_ASSERT(reg.observer().waiting() == 999u);
+
+        reg.set(status::info_id<3, 1>{});
+        TEST_ASSERT(reg.observer().waiting() == 499u);
+        for (unsigned int i = 1u; i < 1000u; ++i) {
+                TEST_ASSERT(tasks[i]->done() == ((i % 2u) == 1u));
+        }
+
+        for (unsigned int i = 1u; i < 1000u; ++i) {
+                delete tasks[i];
+        }
+        TEST_ASSERT(reg.observer().waiting() == 0u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_wakes_on_matching_edge();
+        test_executor_and_rearm();
+        test_edge_before_suspend();
+        test_many_waiters_and_cancel();
+
+        std::fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*
+ * @file: test_status_coro_c.cpp
+ * @brief Unit tests for awaiting edges of the C library's register.
+ *
+ * @note Built against the library sources with STATUS_ENABLE_EDGE_HOOK=1 and
+ *       status_test_config.h.
+ */
+
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+#include "status_coro_c.hpp"
+#include "test_harness.h"
+
+using status::id_class;
+
+/* Coroutine that starts eagerly and keeps its frame until destroyed. */
+struct task {
+        struct promise_type {
+                task
+                get_return_object()
+                {
+                        return task{std::coroutine_handle<promise_type>::from_promise(
+                            *this)};
+                }
+                std::suspend_never initial_suspend() noexcept { return {}; }
+                std::suspend_always final_suspend() noexcept { return {}; }
+                void return_void() noexcept {}
+                void unhandled_exception() { std::terminate(); }
+        };
+
+        explicit task(std::coroutine_handle<promise_type> h) : h(h) {}
+        task(task &&o) noexcept : h(o.h) { o.h = {}; }
+        ~task()
+        {
+                if (h) {
+                        h.destroy();
+                }
+        }
+
+        bool done() const { return h.done(); }
+
+        std::coroutine_handle<promise_type> h;
+};
+
+/* Executor that queues handles until run() is called. */
+struct queue_executor {
+        std::coroutine_handle<> q[8];
+        unsigned int n = 0u;
+
+        void post(std::coroutine_handle<> h) { q[n++] = h; }
+
+        void
+        run()
+        {
+                for (unsigned int i = 0u; i < n; ++i) {
+                        q[i].resume();
+                }
+                n = 0u;
+        }
+};
+
+static task
+wait_id(status::c_register &reg, id_class cls, std::uint16_t id,
+        std::uint16_t *out)
+{
+        *out = co_await status::status_changed(reg, cls, id);
+}
+
+static task
+wait_id_on(status::c_register &reg, queue_executor &ex, std::uint16_t id,
+           unsigned int *edges)
+{
+        for (;;) {
+                co_await status::status_changed(reg, id_class::warning, id, ex);
+                ++*edges;
+        }
+}
+
+/* Another writer sets the ID between creating the awaiter and awaiting. */
+static task
+wait_after_racing_set(status::c_register &reg, std::uint16_t id,
+                      std::uint16_t *out)
+{
+        auto changed = status::status_changed(reg, id_class::info, id);
+
+        status_set_info(id);
+        *out = co_await changed;
+}
+
+/*
+ * Writes through the C API wake the waiter of their bit, but only once
+ * dispatch() runs; writes that change nothing or other bits do not.
+ */
+static void
+test_c_writes_wake(void)
+{
+        status::c_register reg;
+        const std::uint16_t id = STATUS_ENCODE(2u, 5u);
+        std::uint16_t got = 0u;
+
+        status_init();
+        task t = wait_id(reg, id_class::fault, id, &got);
+
+        status_set_fault(STATUS_ENCODE(2u, 4u));
+        status_set_warning(id);
+        TEST_ASSERT(reg.dispatch() == 0u);
+
+        status_set_fault(id);
+        TEST_ASSERT(!t.done());
+        TEST_ASSERT(reg.observer().waiting() == 0u);
+        TEST_ASSERT(reg.dispatch() == 1u);
+        TEST_ASSERT(t.done());
+        TEST_ASSERT(got == 0x0020u);
+
+        /* A clear_all is a clear edge like any other. */
+        task c = wait_id(reg, id_class::fault, id, &got);
+        status_set_fault(id); /* already set: no edge */
+        TEST_ASSERT(reg.dispatch() == 0u);
+        status_clear_all(STATUS_CLASS_FAULT);
+        TEST_ASSERT(reg.dispatch() == 1u);
+        TEST_ASSERT(c.done());
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Posting through an executor, re-arming, and destroying a coroutine that
+ * was woken but not yet dispatched.
+ */
+static void
+test_executor_and_cancel(void)
+{
+        status::c_register reg;
+        const std::uint16_t id = STATUS_ENCODE(1u, 3u);
+        queue_executor ex;
+        unsigned int edges = 0u;
+        std::uint16_t got = 0u;
+
+        status_init();
+        task t = wait_id_on(reg, ex, id, &edges);
+
+        status_set_warning(id);
+        TEST_ASSERT(reg.dispatch() == 1u);
+        TEST_ASSERT(edges == 0u);
+        ex.run();
+        TEST_ASSERT(edges == 1u);
+        status_clear_warning(id);
+        TEST_ASSERT(reg.dispatch() == 1u);
+        ex.run();
+        TEST_ASSERT(edges == 2u);
+
+        {
+                task gone = wait_id(reg, id_class::info, id, &got);
+
+                status_set_info(id);
+        }
+        TEST_ASSERT(reg.dispatch() == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * An edge between creating the awaiter and suspending is not lost.
+ */
+static void
+test_edge_before_suspend(void)
+{
+        status::c_register reg;
+        std::uint16_t got = 0u;
+
+        status_init();
+        task t = wait_after_racing_set(reg, STATUS_ENCODE(0u, 7u), &got);
+        TEST_ASSERT(t.done());
+        TEST_ASSERT(got == 0x0080u);
+        TEST_ASSERT(reg.dispatch() == 0u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_c_writes_wake();
+        test_executor_and_cancel();
+        test_edge_before_suspend();
+
+        std::fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,274 @@
+/*
+ * @file: test_status_deadline.c
+ * @brief Unit tests for the deadline monitor.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Provide no-op critical sections for host-side testing. */
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#include "status.h"
+#include "status_deadline.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+static void
+setUp(void)
+{
+        status_init();
+        status_deadline_init();
+}
+
+/*
+ * A signal kicked within its period never raises its fault.
+ */
+static void
+test_kick_keeps_signal_alive(void)
+{
+        setUp();
+
+        status_deadline_t h = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_CAN_TIMEOUT, 10u, 0u);
+        TEST_ASSERT(h != STATUS_DEADLINE_INVALID);
+
+        for (status_time_t t = 5u; t <= 100u; t += 5u) {
+                status_deadline_kick(h, t);
+                TEST_ASSERT(status_deadline_tick(t) == 0u);
+        }
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT) == false);
+        TEST_ASSERT(status_deadline_expired(h) == false);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A lapsed deadline raises the fault; the next kick clears it again.
+ */
+static void
+test_expiry_sets_and_kick_recovers(void)
+{
+        setUp();
+
+        status_deadline_t h = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_CAN_TIMEOUT, 10u, 0u);
+
+        TEST_ASSERT(status_deadline_tick(9u) == 0u);
+        TEST_ASSERT(status_deadline_tick(10u) == 1u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT) == true);
+        TEST_ASSERT(status_deadline_expired(h) == true);
+
+        /* Expired signals are not reported again on later ticks. */
+        TEST_ASSERT(status_deadline_tick(50u) == 0u);
+
+        status_deadline_kick(h, 60u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT) == false);
+        TEST_ASSERT(status_deadline_expired(h) == false);
+        TEST_ASSERT(status_deadline_tick(69u) == 0u);
+        TEST_ASSERT(status_deadline_tick(70u) == 1u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Only the signals whose deadlines lapsed are expired, in any class.
+ */
+static void
+test_expiry_is_selective(void)
+{
+        setUp();
+
+        status_deadline_t a = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_CAN_TIMEOUT, 10u, 0u);
+        status_deadline_t b = status_deadline_register(
+            STATUS_CLASS_WARNING, STATUS_ID_WARN_BROADCAST_LOSS, 30u, 0u);
+        status_deadline_t c = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_MODULE_MISSING, 20u, 0u);
+
+        status_deadline_kick(a, 15u);
+        TEST_ASSERT(status_deadline_tick(24u) == 1u);
+        TEST_ASSERT(status_deadline_expired(c) == true);
+        TEST_ASSERT(status_deadline_expired(a) == false);
+        TEST_ASSERT(status_deadline_expired(b) == false);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_MODULE_MISSING)
+                    == true);
+
+        TEST_ASSERT(status_deadline_tick(30u) == 2u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT) == true);
+        TEST_ASSERT(status_is_warning_set(STATUS_ID_WARN_BROADCAST_LOSS)
+                    == true);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Deadlines are compared modulo 2^32, so a tick counter wrap is harmless.
+ */
+static void
+test_time_wraparound(void)
+{
+        setUp();
+
+        status_time_t start = 0xFFFFFFF0u;
+        status_deadline_t h = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_CAN_TIMEOUT, 0x20u, start);
+
+        TEST_ASSERT(status_deadline_tick(start + 0x1Fu) == 0u);
+        TEST_ASSERT(status_deadline_tick(start + 0x20u) == 1u);
+        TEST_ASSERT(status_deadline_expired(h) == true);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Invalid arguments and a full table are rejected with the sentinel handle.
+ */
+static void
+test_register_rejects_invalid(void)
+{
+        setUp();
+
+        uint16_t bad_id = STATUS_ENCODE((uint16_t)NUM_STATUS_BANKS, 0u);
+
+        TEST_ASSERT(status_deadline_register(STATUS_CLASS_FAULT, bad_id, 10u,
+                                             0u)
+                    == STATUS_DEADLINE_INVALID);
+        TEST_ASSERT(status_deadline_register((enum status_class)99,
+                                             STATUS_ID_FAULT_CAN_TIMEOUT, 10u,
+                                             0u)
+                    == STATUS_DEADLINE_INVALID);
+        TEST_ASSERT(status_deadline_register(STATUS_CLASS_FAULT,
+                                             STATUS_ID_FAULT_CAN_TIMEOUT, 0u,
+                                             0u)
+                    == STATUS_DEADLINE_INVALID);
+
+        for (size_t i = 0u; i < STATUS_DEADLINE_MAX; ++i) {
+                TEST_ASSERT(status_deadline_register(
+                                STATUS_CLASS_INFO, STATUS_ID_INFO_CAN_ACTIVE,
+                                (status_time_t)(i + 1u), 0u)
+                            != STATUS_DEADLINE_INVALID);
+        }
+        TEST_ASSERT(status_deadline_register(STATUS_CLASS_INFO,
+                                             STATUS_ID_INFO_CAN_ACTIVE, 1u, 0u)
+                    == STATUS_DEADLINE_INVALID);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * An unregistered slot never fires and can be reused.
+ */
+static void
+test_unregister_stops_monitoring(void)
+{
+        setUp();
+
+        status_deadline_t a = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_CAN_TIMEOUT, 10u, 0u);
+        status_deadline_t b = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_MODULE_MISSING, 5u, 0u);
+
+        status_deadline_unregister(b);
+        TEST_ASSERT(status_deadline_tick(10u) == 1u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_MODULE_MISSING)
+                    == false);
+        TEST_ASSERT(status_deadline_expired(a) == true);
+
+        TEST_ASSERT(status_deadline_register(STATUS_CLASS_FAULT,
+                                             STATUS_ID_FAULT_MODULE_MISSING,
+                                             5u, 10u)
+                    == b);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Random kicks across every slot must expire exactly at their deadlines.
+ */
+static void
+test_heap_ordering(void)
+{
+        setUp();
+
+        status_deadline_t h[STATUS_DEADLINE_MAX];
+        status_time_t due[STATUS_DEADLINE_MAX];
+        uint32_t seed = 12345u;
+
+        for (size_t i = 0u; i < STATUS_DEADLINE_MAX; ++i) {
+                h[i] = status_deadline_register(STATUS_CLASS_INFO,
+                                                STATUS_ID_INFO_CAN_ACTIVE,
+                                                1000u, 0u);
+        }
+        for (size_t i = 0u; i < STATUS_DEADLINE_MAX; ++i) {
+                seed = (seed * 1103515245u) + 12345u;
+                status_time_t kick = (seed >> 16u) % 500u;
+                status_deadline_kick(h[i], kick);
+                due[i] = kick + 1000u;
+        }
+
+        size_t total = 0u;
+        for (status_time_t t = 0u; t < 2000u; ++t) {
+                size_t expect = 0u;
+                for (size_t i = 0u; i < STATUS_DEADLINE_MAX; ++i) {
+                        expect += (due[i] == t) ? 1u : 0u;
+                }
+                TEST_ASSERT(status_deadline_tick(t) == expect);
+                total += expect;
+        }
+        TEST_ASSERT(total == STATUS_DEADLINE_MAX);
+        for (size_t i = 0u; i < STATUS_DEADLINE_MAX; ++i) {
+                TEST_ASSERT(status_deadline_expired(h[i]) == true);
+        }
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A kick that moves a deadline earlier (clock stepped back) keeps the heap
+ * ordered, so the earlier deadline still fires first.
+ */
+static void
+test_kick_moves_deadline_earlier(void)
+{
+        setUp();
+
+        status_deadline_t a = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVERCURRENT, 100u, 0u);
+        status_deadline_t b = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVERVOLTAGE, 100u, 50u);
+        status_deadline_t c = status_deadline_register(
+            STATUS_CLASS_FAULT, STATUS_ID_FAULT_CAN_TIMEOUT, 100u, 60u);
+
+        status_deadline_kick(c, (status_time_t)0u - 10u); /* due at 90 */
+        TEST_ASSERT(status_deadline_tick(95u) == 1u);
+        TEST_ASSERT(status_deadline_expired(c));
+        TEST_ASSERT(!status_deadline_expired(a));
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT));
+
+        TEST_ASSERT(status_deadline_tick(100u) == 1u);
+        TEST_ASSERT(status_deadline_expired(a) && !status_deadline_expired(b));
+        TEST_ASSERT(status_deadline_tick(150u) == 1u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_kick_keeps_signal_alive();
+        test_expiry_sets_and_kick_recovers();
+        test_expiry_is_selective();
+        test_time_wraparound();
+        test_register_rejects_invalid();
+        test_unregister_stops_monitoring();
+        test_heap_ordering();
+        test_kick_moves_deadline_earlier();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/*
+ * @file: test_status_deadline_race.c
+ * @brief Tick / kick interleavings of the deadline monitor.
+ *
+ * @note Includes status_deadline.c directly with a critical-section exit
+ *       hook, so that one call can run in the window between the other's
+ *       state change and its register write.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static void race_hook(void);
+
+/* Run the interleaved call on the next exit from a critical section. */
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL() race_hook()
+
+#include "../src/status_deadline.c"
+#include "status_ids.h"
+#include "test_harness.h"
+
+static void (*pending)(void);
+
+static void
+race_hook(void)
+{
+        void (*fn)(void) = pending;
+
+        pending = NULL;
+        if (fn != NULL) {
+                fn();
+        }
+}
+
+static status_deadline_t g_h;
+
+static void
+kick_now(void)
+{
+        status_deadline_kick(g_h, 20u);
+}
+
+static void
+tick_late(void)
+{
+        (void)status_deadline_tick(100u);
+}
+
+static void
+setUp(void)
+{
+        status_init();
+        status_deadline_init();
+        pending = NULL;
+        g_h = status_deadline_register(STATUS_CLASS_FAULT,
+                                       STATUS_ID_FAULT_CAN_TIMEOUT, 10u, 0u);
+        TEST_ASSERT(g_h != STATUS_DEADLINE_INVALID);
+}
+
+/*
+ * A kick lands after tick marked the slot expired but before tick raised
+ * the bit: the bit must end up clear, as the slot says.
+ */
+static void
+test_kick_between_expire_and_set(void)
+{
+        setUp();
+
+        pending = kick_now;
+        TEST_ASSERT(status_deadline_tick(10u) == 1u);
+        TEST_ASSERT(pending == NULL);
+        TEST_ASSERT(!status_deadline_expired(g_h));
+        TEST_ASSERT(!status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT));
+
+        /* Still monitored: the next lapse raises it normally. */
+        TEST_ASSERT(status_deadline_tick(30u) == 1u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT));
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A tick expires the slot again after a kick recovered it but before the
+ * kick cleared the bit: the bit must end up set.
+ */
+static void
+test_tick_between_recover_and_clear(void)
+{
+        setUp();
+
+        TEST_ASSERT(status_deadline_tick(10u) == 1u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT));
+
+        pending = tick_late;
+        status_deadline_kick(g_h, 20u);
+        TEST_ASSERT(pending == NULL);
+        TEST_ASSERT(status_deadline_expired(g_h));
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT));
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_kick_between_expire_and_set();
+        test_tick_between_recover_and_clear();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
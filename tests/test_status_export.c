@@ -0,0 +1,230 @@
+/*
+ * @file: test_status_export.c
+ * @brief Unit tests for the streaming JSON/CBOR exporter.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Provide no-op critical sections for host-side testing. */
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#include "status.h"
+#include "status_export.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+#define OUT_MAX (512u)
+
+static uint8_t out[OUT_MAX];
+
+static void
+setUp(void)
+{
+        status_init();
+}
+
+static const char *
+test_names(enum status_class cls, uint16_t id)
+{
+        if ((cls == STATUS_CLASS_FAULT) && (id == STATUS_ID_FAULT_OVERCURRENT)) {
+                return "FAULT_OVERCURRENT";
+        }
+        if ((cls == STATUS_CLASS_INFO) && (id == STATUS_ID_INFO_AC_LIVE)) {
+                return "AC \"live\"\\\n";
+        }
+        return NULL;
+}
+
+/* Drain a whole document using `chunk`-byte writes. */
+static size_t
+export_all(enum status_export_format fmt, status_export_name_fn names,
+           size_t chunk)
+{
+        struct status_exporter x;
+        size_t len = 0u;
+
+        status_export_begin(&x, fmt, names);
+        while (!status_export_done(&x)) {
+                size_t cap = chunk;
+
+                if (cap > (OUT_MAX - len)) {
+                        cap = OUT_MAX - len;
+                }
+                size_t n = status_export_step(&x, &out[len], cap);
+
+                TEST_ASSERT((n == cap) || status_export_done(&x));
+                len += n;
+        }
+        TEST_ASSERT(status_export_step(&x, &out[len], OUT_MAX - len) == 0u);
+
+        return len;
+}
+
+static void
+setup_active(void)
+{
+        setUp();
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_set_fault(STATUS_ID_FAULT_DC_BUS_FAULT);
+        status_set_fault(STATUS_ID_FAULT_MODULE_MISSING);
+        status_set_info(STATUS_ID_INFO_AC_LIVE);
+}
+
+/*
+ * Empty registers give empty arrays.
+ */
+static void
+test_json_empty(void)
+{
+        setUp();
+
+        const char *expect = "{\"fault\":[],\"warning\":[],\"info\":[]}";
+        size_t len = export_all(STATUS_EXPORT_JSON, NULL, OUT_MAX);
+
+        TEST_ASSERT(len == strlen(expect));
+        TEST_ASSERT(memcmp(out, expect, len) == 0);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Active IDs are listed in ascending order per class.
+ */
+static void
+test_json_ids(void)
+{
+        setup_active();
+
+        const char *expect =
+            "{\"fault\":[0,3,33],\"warning\":[],\"info\":[0]}";
+        size_t len = export_all(STATUS_EXPORT_JSON, NULL, OUT_MAX);
+
+        TEST_ASSERT(len == strlen(expect));
+        TEST_ASSERT(memcmp(out, expect, len) == 0);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Named IDs become objects; names are escaped; unnamed IDs stay bare.
+ */
+static void
+test_json_names(void)
+{
+        setup_active();
+
+        const char *expect = "{\"fault\":[{\"id\":0,\"name\":"
+                             "\"FAULT_OVERCURRENT\"},3,33],"
+                             "\"warning\":[],"
+                             "\"info\":[{\"id\":0,\"name\":"
+                             "\"AC \\\"live\\\"\\\\\\u000a\"}]}";
+        size_t len = export_all(STATUS_EXPORT_JSON, test_names, OUT_MAX);
+
+        TEST_ASSERT(len == strlen(expect));
+        TEST_ASSERT(memcmp(out, expect, len) == 0);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * CBOR output uses definite-length containers.
+ */
+static void
+test_cbor(void)
+{
+        setup_active();
+        status_set_warning(STATUS_ID_WARN_BROADCAST_LOSS); /* ID 81 */
+
+        static const uint8_t expect[] = {
+                0xA3,                               /* map(3) */
+                0x65, 'f', 'a', 'u', 'l', 't', 0x83, /* "fault": [3] */
+                0x82, 0x00, 0x71, 'F', 'A', 'U', 'L', 'T', '_', 'O', 'V',
+                'E', 'R', 'C', 'U', 'R', 'R', 'E', 'N', 'T', /* [0, name] */
+                0x03, 0x18, 0x21,                   /* 3, 33 */
+                0x67, 'w', 'a', 'r', 'n', 'i', 'n', 'g', 0x81, /* [1] */
+                0x18, 0x51,                         /* 81 */
+                0x64, 'i', 'n', 'f', 'o', 0x81,     /* "info": [1] */
+                0x82, 0x00, 0x6B, 'A', 'C', ' ', '"', 'l', 'i', 'v', 'e',
+                '"', '\\', '\n',
+        };
+        size_t len = export_all(STATUS_EXPORT_CBOR, test_names, OUT_MAX);
+
+        TEST_ASSERT(len == sizeof(expect));
+        TEST_ASSERT(memcmp(out, expect, len) == 0);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Any buffer size produces the same bytes as a single large write.
+ */
+static void
+test_resume_any_chunk(void)
+{
+        static uint8_t ref[OUT_MAX];
+
+        setup_active();
+        for (uint16_t b = 6u; b < NUM_STATUS_BANKS; ++b) {
+                status_set_warning(STATUS_ENCODE(b, (uint16_t)(b % 16u)));
+        }
+
+        for (int f = 0; f < 2; ++f) {
+                const enum status_export_format fmt =
+                    (f == 0) ? STATUS_EXPORT_JSON : STATUS_EXPORT_CBOR;
+                const size_t ref_len = export_all(fmt, test_names, OUT_MAX);
+
+                memcpy(ref, out, ref_len);
+                for (size_t chunk = 1u; chunk <= 32u; ++chunk) {
+                        TEST_ASSERT(export_all(fmt, test_names, chunk)
+                                    == ref_len);
+                        TEST_ASSERT(memcmp(out, ref, ref_len) == 0);
+                }
+        }
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * The document reflects the registers at status_export_begin().
+ */
+static void
+test_snapshot_isolation(void)
+{
+        struct status_exporter x;
+        size_t len;
+
+        setUp();
+        status_set_fault(STATUS_ID_FAULT_OVERVOLTAGE);
+        status_export_begin(&x, STATUS_EXPORT_JSON, NULL);
+        len = status_export_step(&x, out, 4u);
+        status_clear_fault(STATUS_ID_FAULT_OVERVOLTAGE);
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        len += status_export_step(&x, &out[len], OUT_MAX - len);
+
+        const char *expect = "{\"fault\":[1],\"warning\":[],\"info\":[]}";
+        TEST_ASSERT(status_export_done(&x));
+        TEST_ASSERT(len == strlen(expect));
+        TEST_ASSERT(memcmp(out, expect, len) == 0);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_json_empty();
+        test_json_ids();
+        test_json_names();
+        test_cbor();
+        test_resume_any_chunk();
+        test_snapshot_isolation();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/*
+ * @file: test_status_gen.c
+ * @brief Unit tests for the tables generated from status_ids.csv.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "status.h"
+#include "status_ids_gen.h"
+#include "test_harness.h"
+
+static void
+setUp(void)
+{
+        status_init();
+}
+
+/*
+ * Generated IDs follow the bank/bit columns of the definition.
+ */
+static void
+test_ids_match_definition(void)
+{
+        TEST_ASSERT(STATUS_ID_FAULT_OVERCURRENT == STATUS_ENCODE(0u, 0u));
+        TEST_ASSERT(STATUS_ID_FAULT_DC_BUS_FAULT == STATUS_ENCODE(0u, 3u));
+        TEST_ASSERT(STATUS_ID_FAULT_MODULE_MISSING == STATUS_ENCODE(2u, 1u));
+        TEST_ASSERT(STATUS_ID_WARN_BROADCAST_LOSS == STATUS_ENCODE(5u, 1u));
+        TEST_ASSERT(STATUS_ID_INFO_CAN_ACTIVE == STATUS_ENCODE(2u, 0u));
+        TEST_ASSERT(STATUS_GEN_NUM_BANKS == 6u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Group masks cover exactly the members of each group in each bank.
+ */
+static void
+test_group_masks(void)
+{
+        TEST_ASSERT(STATUS_GROUP_POWER_FAULT_B0 == 0x000Fu);
+        TEST_ASSERT(STATUS_GROUP_THERMAL_FAULT_B1
+                    == ((1u << status_bit(STATUS_ID_FAULT_OVER_TEMP_AFE))
+                        | (1u << status_bit(STATUS_ID_FAULT_OVER_TEMP_INV))));
+        TEST_ASSERT(STATUS_GROUP_COMM_WARNING_B5 == 0x0003u);
+        TEST_ASSERT(STATUS_GROUP_COMM_INFO_B2 == 0x0001u);
+
+        /* Term initialisers select the same IDs. */
+        static const struct status_query_term thermal[] =
+            STATUS_GROUP_THERMAL_FAULT_TERMS;
+
+        status_init();
+        TEST_ASSERT(!status_query_any(STATUS_CLASS_FAULT, thermal, 1u));
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_INV);
+        TEST_ASSERT(status_query_any(STATUS_CLASS_FAULT, thermal, 1u));
+        TEST_ASSERT((sizeof(thermal) / sizeof(thermal[0])) == 1u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * The dense table maps every defined ID to its name and nothing else.
+ */
+static void
+test_id_to_name_table(void)
+{
+        size_t named = 0u;
+
+        TEST_ASSERT(strcmp(status_names[STATUS_CLASS_FAULT]
+                                       [STATUS_ID_FAULT_OVERCURRENT],
+                           "FAULT_OVERCURRENT")
+                    == 0);
+        TEST_ASSERT(strcmp(status_names[STATUS_CLASS_INFO]
+                                       [STATUS_ID_INFO_AC_LIVE],
+                           "INFO_AC_LIVE")
+                    == 0);
+        TEST_ASSERT(status_names[STATUS_CLASS_WARNING][0] == NULL);
+
+        for (size_t c = 0u; c < 3u; ++c) {
+                for (size_t i = 0u; i < STATUS_NAMES_LEN; ++i) {
+                        named += (status_names[c][i] != NULL) ? 1u : 0u;
+                }
+        }
+        TEST_ASSERT(named == STATUS_NAME_COUNT);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Every name hashes straight to its own slot, and the slot agrees with the
+ * dense table.
+ */
+static void
+test_perfect_hash_slots(void)
+{
+        for (size_t i = 0u; i < STATUS_NAME_COUNT; ++i) {
+                const struct status_name_entry *e = &status_name_slots[i];
+                size_t len = strlen(e->name);
+                uint32_t b = status_name_hash(e->name, len, 0u)
+                             % STATUS_NAME_BUCKETS;
+                uint32_t s = status_name_hash(e->name, len,
+                                              status_name_disp[b])
+                             % STATUS_NAME_COUNT;
+
+                TEST_ASSERT(s == i);
+                TEST_ASSERT(e->cls < 3u);
+                TEST_ASSERT(strcmp(status_names[e->cls][e->id], e->name)
+                            == 0);
+        }
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * The generated metadata table drives the priority query.
+ */
+static void
+test_generated_meta_table(void)
+{
+        setUp();
+
+        TEST_ASSERT(strcmp(status_meta_name(STATUS_CLASS_FAULT,
+                                            STATUS_ID_FAULT_CAN_TIMEOUT),
+                           "STATUS_ID_FAULT_CAN_TIMEOUT")
+                    == 0);
+        TEST_ASSERT(status_meta_group(STATUS_CLASS_WARNING,
+                                      STATUS_ID_WARN_FAN_PERF_DROP)
+                    == STATUS_GROUP_THERMAL);
+
+        status_set_fault(STATUS_ID_FAULT_MODULE_MISSING);
+        status_set_fault(STATUS_ID_FAULT_OVERVOLTAGE);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_OVERVOLTAGE);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_ids_match_definition();
+        test_group_masks();
+        test_id_to_name_table();
+        test_perfect_hash_slots();
+        test_generated_meta_table();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
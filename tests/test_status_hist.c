@@ -0,0 +1,186 @@
+/*
+ * @file: test_status_hist.c
+ * @brief Unit tests for fault duration histograms.
+ *
+ * @note Built with STATUS_ENABLE_HISTOGRAM=1 and status_test_config.h.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "status.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+#define HIST_LEN (STATUS_HIST_SLOTS * STATUS_HIST_BUCKETS)
+
+static status_err_t g_last_err;
+static unsigned int g_err_count;
+
+static void
+test_err_cb(status_err_t err, uint16_t id)
+{
+        (void)id;
+        g_last_err = err;
+        ++g_err_count;
+}
+
+static void
+setUp(void)
+{
+        status_test_clock = 0u;
+        status_init();
+        status_set_err_callback(test_err_cb);
+        g_err_count = 0u;
+        for (uint16_t i = 0u; i < (uint16_t)(NUM_STATUS_BANKS * NUM_STATUS_BITS);
+             ++i) {
+                status_hist_bind(STATUS_CLASS_FAULT, i, STATUS_HIST_NONE);
+                status_hist_bind(STATUS_CLASS_WARNING, i, STATUS_HIST_NONE);
+        }
+}
+
+static void
+pulse_warning(uint16_t id, status_time_t width)
+{
+        status_set_warning(id);
+        status_test_clock += width;
+        status_clear_warning(id);
+        status_test_clock += 1000u;
+}
+
+/*
+ * Durations land in floor(log2(d)) buckets; the last bucket saturates.
+ */
+static void
+test_log2_buckets(void)
+{
+        setUp();
+
+        uint32_t h[HIST_LEN];
+
+        status_hist_bind(STATUS_CLASS_WARNING, STATUS_ID_WARN_CAN_LOAD_HIGH, 0u);
+
+        pulse_warning(STATUS_ID_WARN_CAN_LOAD_HIGH, 0u);
+        pulse_warning(STATUS_ID_WARN_CAN_LOAD_HIGH, 1u);
+        pulse_warning(STATUS_ID_WARN_CAN_LOAD_HIGH, 3u);
+        pulse_warning(STATUS_ID_WARN_CAN_LOAD_HIGH, 4u);
+        pulse_warning(STATUS_ID_WARN_CAN_LOAD_HIGH, 7u);
+        pulse_warning(STATUS_ID_WARN_CAN_LOAD_HIGH, 1024u);
+        pulse_warning(STATUS_ID_WARN_CAN_LOAD_HIGH, 0x40000000u);
+
+        status_hist_export(h, HIST_LEN);
+        TEST_ASSERT(h[0] == 2u);
+        TEST_ASSERT(h[1] == 1u);
+        TEST_ASSERT(h[2] == 2u);
+        TEST_ASSERT(h[10] == 1u);
+        TEST_ASSERT(h[STATUS_HIST_BUCKETS - 1u] == 1u);
+        TEST_ASSERT(h[STATUS_HIST_BUCKETS] == 0u); /* slot 1 untouched */
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Only clear edges of bound IDs are recorded; an active ID is not counted
+ * until it clears.
+ */
+static void
+test_only_bound_clear_edges(void)
+{
+        setUp();
+
+        uint32_t h[HIST_LEN];
+
+        status_hist_bind(STATUS_CLASS_WARNING, STATUS_ID_WARN_CAN_LOAD_HIGH, 2u);
+        pulse_warning(STATUS_ID_WARN_BROADCAST_LOSS, 8u); /* unbound */
+        status_set_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+        status_test_clock += 8u;
+
+        status_hist_export(h, HIST_LEN);
+        for (size_t i = 0u; i < HIST_LEN; ++i) {
+                TEST_ASSERT(h[i] == 0u);
+        }
+
+        status_clear_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+        status_hist_export(h, HIST_LEN);
+        TEST_ASSERT(h[(2u * STATUS_HIST_BUCKETS) + 3u] == 1u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Several IDs bound to one slot form a group histogram; clear_all records
+ * every active member.
+ */
+static void
+test_group_slot_and_clear_all(void)
+{
+        setUp();
+
+        uint32_t h[HIST_LEN];
+
+        status_hist_bind(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVER_TEMP_AFE, 1u);
+        status_hist_bind(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVER_TEMP_INV, 1u);
+
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_AFE);
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_INV);
+        status_test_clock += 20u;
+        status_clear_all(STATUS_CLASS_FAULT);
+
+        status_hist_export(h, HIST_LEN);
+        TEST_ASSERT(h[STATUS_HIST_BUCKETS + 4u] == 2u);
+
+        /* status_init resets counters but keeps bindings. */
+        status_init();
+        status_hist_export(h, HIST_LEN);
+        TEST_ASSERT(h[STATUS_HIST_BUCKETS + 4u] == 0u);
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_AFE);
+        status_clear_fault(STATUS_ID_FAULT_OVER_TEMP_AFE);
+        status_hist_export(h, HIST_LEN);
+        TEST_ASSERT(h[STATUS_HIST_BUCKETS] == 1u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Invalid bindings and export arguments are reported.
+ */
+static void
+test_invalid_arguments(void)
+{
+        setUp();
+
+        uint32_t h[HIST_LEN];
+
+        status_hist_bind(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVERCURRENT,
+                         (uint8_t)STATUS_HIST_SLOTS);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+        status_hist_bind(STATUS_CLASS_FAULT,
+                         STATUS_ENCODE((uint16_t)NUM_STATUS_BANKS, 0u), 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        status_hist_bind((enum status_class)99, STATUS_ID_FAULT_OVERCURRENT,
+                         0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ID);
+        status_hist_export(NULL, HIST_LEN);
+        TEST_ASSERT(g_last_err == STATUS_ERR_NULL_PTR);
+        status_hist_export(h, 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_LEN);
+        TEST_ASSERT(g_err_count == 5u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_log2_buckets();
+        test_only_bound_clear_edges();
+        test_group_slot_and_clear_all();
+        test_invalid_arguments();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
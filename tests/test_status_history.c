@@ -0,0 +1,182 @@
+/*
+ * @file: test_status_history.c
+ * @brief Unit tests for the checkpoint + delta history.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Provide no-op critical sections for host-side testing. */
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#include "status.h"
+#include "status_history.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+#define SAMPLES (2000u)
+
+/* Reference copy of every sample, to check the reconstruction against. */
+static uint16_t ref[SAMPLES][3][NUM_STATUS_BANKS];
+
+static void
+setUp(void)
+{
+        status_init();
+        status_history_init();
+}
+
+static uint32_t
+lcg(uint32_t *s)
+{
+        *s = (*s * 1664525u) + 1013904223u;
+        return *s >> 8u;
+}
+
+/*
+ * Points between and on samples reconstruct the state of the latest sample
+ * not after them; points before the first sample are not in the history.
+ */
+static void
+test_state_at_time(void)
+{
+        setUp();
+
+        uint16_t banks[NUM_STATUS_BANKS];
+        status_time_t first = 0u;
+        status_time_t last = 0u;
+
+        TEST_ASSERT(!status_history_at(0u, STATUS_CLASS_FAULT, banks));
+        TEST_ASSERT(!status_history_span(&first, &last));
+
+        TEST_ASSERT(status_history_sample(100u) == 0u);
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_set_warning(STATUS_ID_WARN_TEMP_NEAR_LIMIT);
+        TEST_ASSERT(status_history_sample(110u) == 2u);
+        TEST_ASSERT(status_history_sample(120u) == 0u);
+        status_clear_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_set_fault(STATUS_ID_FAULT_CAN_TIMEOUT);
+        TEST_ASSERT(status_history_sample(130u) == 2u);
+
+        TEST_ASSERT(!status_history_at(99u, STATUS_CLASS_FAULT, banks));
+        TEST_ASSERT(status_history_at(105u, STATUS_CLASS_FAULT, banks));
+        TEST_ASSERT(banks[0] == 0u);
+
+        TEST_ASSERT(status_history_at(110u, STATUS_CLASS_FAULT, banks));
+        TEST_ASSERT(banks[0] == 0x0001u);
+        TEST_ASSERT(status_history_at(129u, STATUS_CLASS_FAULT, banks));
+        TEST_ASSERT(banks[0] == 0x0001u);
+        TEST_ASSERT(banks[2] == 0u);
+        TEST_ASSERT(status_history_at(129u, STATUS_CLASS_WARNING, banks));
+        TEST_ASSERT(banks[status_bank(STATUS_ID_WARN_TEMP_NEAR_LIMIT)]
+                    == (uint16_t)(1u << status_bit(STATUS_ID_WARN_TEMP_NEAR_LIMIT)));
+
+        TEST_ASSERT(status_history_at(5000u, STATUS_CLASS_FAULT, banks));
+        TEST_ASSERT((banks[0] == 0u) && (banks[2] == 0x0001u));
+
+        TEST_ASSERT(status_history_span(&first, &last));
+        TEST_ASSERT((first == 100u) && (last == 130u));
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Random activity over many samples: the oldest segments are evicted and
+ * every retained sample is reconstructed exactly, across a clock wrap.
+ */
+static void
+test_eviction_and_reconstruction(void)
+{
+        setUp();
+
+        const status_time_t t0 = 0xFFFFF000u;
+        uint32_t seed = 12345u;
+        uint16_t banks[NUM_STATUS_BANKS];
+        status_time_t first = 0u;
+        status_time_t last = 0u;
+
+        for (size_t k = 0u; k < SAMPLES; ++k) {
+                const uint32_t r = lcg(&seed);
+                const uint16_t id = STATUS_ENCODE((r >> 4u) % NUM_STATUS_BANKS,
+                                                  r & 0x0Fu);
+
+                /* Roughly one sample in three changes something. */
+                if ((r % 3u) == 0u) {
+                        if ((r & 0x1000u) != 0u) {
+                                status_set_fault(id);
+                        } else {
+                                status_clear_fault(id);
+                        }
+                        status_set_info(id);
+                }
+                (void)status_history_sample(t0 + (status_time_t)(k * 4u));
+                status_snapshot(STATUS_CLASS_FAULT, ref[k][0], NUM_STATUS_BANKS);
+                status_snapshot(STATUS_CLASS_WARNING, ref[k][1],
+                                NUM_STATUS_BANKS);
+                status_snapshot(STATUS_CLASS_INFO, ref[k][2], NUM_STATUS_BANKS);
+        }
+
+        TEST_ASSERT(status_history_span(&first, &last));
+        TEST_ASSERT(last == t0 + (status_time_t)((SAMPLES - 1u) * 4u));
+        TEST_ASSERT(first != t0); /* the start has been evicted */
+        TEST_ASSERT(!status_history_at(first - 1u, STATUS_CLASS_FAULT, banks));
+
+        size_t checked = 0u;
+
+        for (size_t k = 0u; k < SAMPLES; ++k) {
+                const status_time_t t = t0 + (status_time_t)(k * 4u);
+
+                if ((uint32_t)(t - first) > (uint32_t)(last - first)) {
+                        continue;
+                }
+                for (unsigned int c = 0u; c < 3u; ++c) {
+                        TEST_ASSERT(status_history_at(
+                            t + 1u, (enum status_class)c, banks));
+                        TEST_ASSERT(memcmp(banks, ref[k][c], sizeof(banks))
+                                    == 0);
+                }
+                ++checked;
+        }
+        TEST_ASSERT(checked > STATUS_HISTORY_CHECKPOINTS);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Bad arguments are rejected without touching dst.
+ */
+static void
+test_invalid_args(void)
+{
+        setUp();
+
+        uint16_t banks[NUM_STATUS_BANKS];
+
+        (void)status_history_sample(1u);
+        banks[0] = 0xABCDu;
+        TEST_ASSERT(!status_history_at(1u, (enum status_class)7, banks));
+        TEST_ASSERT(banks[0] == 0xABCDu);
+        TEST_ASSERT(!status_history_at(1u, STATUS_CLASS_FAULT, NULL));
+        TEST_ASSERT(status_history_span(NULL, NULL));
+
+        status_history_init();
+        TEST_ASSERT(!status_history_at(1u, STATUS_CLASS_FAULT, banks));
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_state_at_time();
+        test_eviction_and_reconstruction();
+        test_invalid_args();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*
+ * @file: test_status_hpp.cpp
+ * @brief Unit tests for the header-only C++ status register.
+ *
+ * @note Cross-class use and out-of-range IDs are rejected at compile time,
+ *       so they have no runtime test; see the static_asserts in status.hpp.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#include "status.h"
+#include "status.hpp"
+#include "test_harness.h"
+
+using status::fault_id;
+using status::id_class;
+using status::info_id;
+using status::warning_id;
+
+using overcurrent = fault_id<0, 1>;
+using can_load = warning_id<2, 15>;
+using last_info = info_id<NUM_STATUS_BANKS - 1u, 0>;
+
+/* Class is part of the type: equal bank/bit in two classes are distinct. */
+static_assert(!std::is_same_v<fault_id<0, 1>, warning_id<0, 1>>);
+static_assert(overcurrent::value == STATUS_ENCODE(0u, 1u));
+static_assert(can_load::value == STATUS_ENCODE(2u, 15u));
+
+/*
+ * set/clear/is_set touch only the bit named by the type.
+ */
+static void
+test_set_clear_is_set(void)
+{
+        static status::status_register<NUM_STATUS_BANKS> reg;
+
+        TEST_ASSERT(!reg.is_set(overcurrent{}));
+        reg.set(overcurrent{});
+        TEST_ASSERT(reg.is_set(overcurrent{}));
+        TEST_ASSERT(!reg.is_set(warning_id<0, 1>{}));
+        TEST_ASSERT(!reg.is_set(fault_id<0, 0>{}));
+
+        reg.set<can_load>();
+        reg.set<last_info>();
+        TEST_ASSERT(reg.is_set<can_load>());
+        TEST_ASSERT(reg.is_set<last_info>());
+
+        reg.clear(overcurrent{});
+        TEST_ASSERT(!reg.is_set(overcurrent{}));
+        TEST_ASSERT(reg.is_set<can_load>());
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Whole-class operations.
+ */
+static void
+test_any_clear_all_snapshot(void)
+{
+        using top = fault_id<NUM_STATUS_BANKS - 1u, 15>;
+        static status::status_register<NUM_STATUS_BANKS> reg;
+        std::uint16_t snap[NUM_STATUS_BANKS + 2u] = {};
+
+        TEST_ASSERT(!reg.any(id_class::fault));
+        reg.set<top>();
+        reg.set<fault_id<3, 4>>();
+        TEST_ASSERT(reg.any(id_class::fault));
+        TEST_ASSERT(!reg.any(id_class::warning));
+
+        TEST_ASSERT(reg.snapshot(id_class::fault, snap, NUM_STATUS_BANKS + 2u)
+                    == NUM_STATUS_BANKS);
+        TEST_ASSERT(snap[3] == 0x0010u);
+        TEST_ASSERT(snap[NUM_STATUS_BANKS - 1u] == 0x8000u);
+        TEST_ASSERT(reg.snapshot(id_class::fault, snap, 1u) == 1u);
+
+        reg.clear_all(id_class::fault);
+        TEST_ASSERT(!reg.any(id_class::fault));
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Wider words extend the bit range.
+ */
+static void
+test_wide_word(void)
+{
+        using top = info_id<1, 63>;
+        static status::status_register<2, std::uint64_t> reg;
+        std::uint64_t snap[2] = {};
+
+        reg.set<top>();
+        TEST_ASSERT(reg.is_set<top>());
+        TEST_ASSERT(reg.snapshot(id_class::info, snap, 2u) == 2u);
+        TEST_ASSERT(snap[1] == (std::uint64_t{1} << 63u));
+        static_assert(decltype(reg)::bits_per_bank == 64u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_set_clear_is_set();
+        test_any_clear_all_snapshot();
+        test_wide_word();
+
+        std::fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+/*
+ * @file: test_status_integrity.c
+ * @brief Unit tests for the incremental integrity checksum.
+ *
+ * @note Includes status.c directly so that the tests can corrupt the banks
+ *       behind the API's back.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/status.c"
+#include "status_ids.h"
+#include "test_harness.h"
+
+static unsigned int integrity_errs;
+
+static void
+count_err(status_err_t err, uint16_t id)
+{
+        (void)id;
+        if (err == STATUS_ERR_INTEGRITY) {
+                ++integrity_errs;
+        }
+}
+
+static void
+setUp(void)
+{
+        status_init();
+        status_set_err_callback(count_err);
+        integrity_errs = 0u;
+}
+
+/* Run whole background passes and report whether all of them passed. */
+static bool
+full_pass(enum status_class cls)
+{
+        return status_verify_step(cls, NUM_STATUS_BANKS);
+}
+
+/*
+ * Normal set/clear/clear_all traffic keeps every check green.
+ */
+static void
+test_api_traffic_verifies(void)
+{
+        setUp();
+
+        for (uint16_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                status_set_fault(STATUS_ENCODE(b, (uint16_t)(b % 16u)));
+                status_set_warning(STATUS_ENCODE(b, 15u));
+        }
+        status_clear_fault(STATUS_ENCODE(3u, 3u));
+        status_clear_all(STATUS_CLASS_WARNING);
+        status_set_info(STATUS_ID_INFO_CAN_ACTIVE);
+
+        for (int c = 0; c < 3; ++c) {
+                TEST_ASSERT(status_verify((enum status_class)c));
+                TEST_ASSERT(full_pass((enum status_class)c));
+        }
+        TEST_ASSERT(integrity_errs == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A bit flip in any bank is caught by the next completed pass.
+ */
+static void
+test_bit_flip_detected(void)
+{
+        for (uint16_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                setUp();
+                status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+
+                fault_banks[b] ^= (uint16_t)(1u << (b % 16u));
+                TEST_ASSERT(status_verify(STATUS_CLASS_FAULT));
+                TEST_ASSERT(!full_pass(STATUS_CLASS_FAULT));
+                TEST_ASSERT(integrity_errs == 1u);
+                TEST_ASSERT(full_pass(STATUS_CLASS_WARNING));
+        }
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Corruption of the integrity word itself is caught in O(1).
+ */
+static void
+test_check_word_corruption(void)
+{
+        setUp();
+        status_set_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+
+        chk_sum[STATUS_CLASS_WARNING] ^= 0x10u;
+        TEST_ASSERT(!status_verify(STATUS_CLASS_WARNING));
+        TEST_ASSERT(integrity_errs == 1u);
+        TEST_ASSERT(status_verify(STATUS_CLASS_FAULT));
+
+        TEST_ASSERT(!status_verify((enum status_class)5));
+        TEST_ASSERT(integrity_errs == 1u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Writes interleaved with a pass, before and after the cursor, do not cause
+ * false alarms.
+ */
+static void
+test_pass_with_concurrent_writes(void)
+{
+        setUp();
+
+        for (int round = 0; round < 4; ++round) {
+                for (uint16_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                        TEST_ASSERT(status_verify_step(STATUS_CLASS_FAULT, 1u));
+                        status_set_fault(STATUS_ENCODE(0u, (uint16_t)b % 16u));
+                        status_set_fault(
+                            STATUS_ENCODE((uint16_t)(NUM_STATUS_BANKS - 1u),
+                                          (uint16_t)(b % 16u)));
+                        if ((b % 5u) == 0u) {
+                                status_clear_all(STATUS_CLASS_FAULT);
+                        }
+                }
+        }
+        TEST_ASSERT(integrity_errs == 0u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_api_traffic_verifies();
+        test_bit_flip_detected();
+        test_check_word_corruption();
+        test_pass_with_concurrent_writes();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
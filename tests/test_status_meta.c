@@ -0,0 +1,237 @@
+/*
+ * @file: test_status_meta.c
+ * @brief Unit tests for the const metadata table and the features driven by
+ *        it (debounce, latching, priority).
+ *
+ * @note Built with STATUS_ENABLE_META=1, STATUS_ENABLE_PRIORITY=1,
+ *       STATUS_ENABLE_SOURCES=1 and status_test_config.h. Defines its own
+ *       status_meta_table.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "status.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+#define TEST_ID_LATCHED   STATUS_ENCODE(6u, 0u)
+#define TEST_ID_DEBOUNCED STATUS_ENCODE(6u, 1u)
+
+#define TEST_FAULT_META(X)                                                     \
+        STATUS_FAULT_META(X)                                                   \
+        X(TEST_ID_LATCHED,   252u, 4u, 9u, STATUS_META_LATCH, 0u)              \
+        X(TEST_ID_DEBOUNCED, 251u, 1u, 9u, 0u, 3u)
+
+const struct status_meta status_meta_table[3][STATUS_META_LEN] = {
+        [STATUS_CLASS_FAULT] = {TEST_FAULT_META(STATUS_META_ENTRY)},
+        [STATUS_CLASS_WARNING] = {STATUS_WARN_META(STATUS_META_ENTRY)},
+};
+
+static status_err_t g_last_err;
+static unsigned int g_err_count;
+
+static void
+test_err_cb(status_err_t err, uint16_t id)
+{
+        (void)id;
+        g_last_err = err;
+        ++g_err_count;
+}
+
+static void
+setUp(void)
+{
+        status_set_err_callback(test_err_cb);
+        g_err_count = 0u;
+        status_init();
+        TEST_ASSERT(g_err_count == 0u); /* every table rank was accepted */
+}
+
+/*
+ * Accessors index the table directly; unlisted entries are zero.
+ */
+static void
+test_accessors(void)
+{
+        setUp();
+
+        TEST_ASSERT(strcmp(status_meta_name(STATUS_CLASS_FAULT,
+                                            STATUS_ID_FAULT_CAN_TIMEOUT),
+                           "STATUS_ID_FAULT_CAN_TIMEOUT")
+                    == 0);
+        TEST_ASSERT(status_meta_severity(STATUS_CLASS_FAULT,
+                                         STATUS_ID_FAULT_OVERCURRENT)
+                    == 3u);
+        TEST_ASSERT(status_meta_group(STATUS_CLASS_WARNING,
+                                      STATUS_ID_WARN_CAN_LOAD_HIGH)
+                    == 3u);
+
+        /* Unlisted IDs and the empty info table. */
+        TEST_ASSERT(status_meta_name(STATUS_CLASS_FAULT, STATUS_ENCODE(7u, 3u))
+                    == NULL);
+        TEST_ASSERT(status_meta_get(STATUS_CLASS_INFO, STATUS_ID_INFO_AC_LIVE)
+                        ->prio
+                    == 0u);
+
+        /* Out of range. */
+        TEST_ASSERT(status_meta_get((enum status_class)3, 0u) == NULL);
+        TEST_ASSERT(status_meta_get(STATUS_CLASS_FAULT,
+                                    (uint16_t)STATUS_META_LEN)
+                    == NULL);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Latched IDs ignore clear requests until acknowledged; clear_all resets.
+ */
+static void
+test_latch(void)
+{
+        setUp();
+
+        status_set_fault(TEST_ID_LATCHED);
+        status_clear_fault(TEST_ID_LATCHED);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_LATCHED) == true);
+
+        status_ack(STATUS_CLASS_FAULT, TEST_ID_LATCHED);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_LATCHED) == false);
+
+        status_set_fault(TEST_ID_LATCHED);
+        status_clear_all(STATUS_CLASS_FAULT);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_LATCHED) == false);
+
+        /* Non-latched IDs clear normally. */
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_clear_fault(STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT) == false);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A debounced ID is raised on the N-th consecutive set; a clear restarts it.
+ */
+static void
+test_debounce(void)
+{
+        setUp();
+
+        status_set_fault(TEST_ID_DEBOUNCED);
+        status_set_fault(TEST_ID_DEBOUNCED);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_DEBOUNCED) == false);
+        TEST_ASSERT(status_last_fault() == STATUS_UNSET_ID);
+
+        status_clear_fault(TEST_ID_DEBOUNCED);
+        status_set_fault(TEST_ID_DEBOUNCED);
+        status_set_fault(TEST_ID_DEBOUNCED);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_DEBOUNCED) == false);
+        status_set_fault(TEST_ID_DEBOUNCED);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_DEBOUNCED) == true);
+        TEST_ASSERT(status_last_fault() == TEST_ID_DEBOUNCED);
+
+        /* Stays set on further requests, drops on the first clear. */
+        status_set_fault(TEST_ID_DEBOUNCED);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_DEBOUNCED) == true);
+        status_clear_fault(TEST_ID_DEBOUNCED);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_DEBOUNCED) == false);
+
+        /* status_init restarts the count. */
+        status_set_fault(TEST_ID_DEBOUNCED);
+        status_set_fault(TEST_ID_DEBOUNCED);
+        status_init();
+        status_set_fault(TEST_ID_DEBOUNCED);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_DEBOUNCED) == false);
+
+        TEST_PASS(__func__);
+}
+
+#if STATUS_ENABLE_SOURCES
+/*
+ * A source is recorded only by a set that debounce accepts, so releasing
+ * the source that raised the ID clears it.
+ */
+static void
+test_debounce_with_sources(void)
+{
+        setUp();
+
+        status_source_set(STATUS_CLASS_FAULT, TEST_ID_DEBOUNCED, 0u);
+        status_source_set(STATUS_CLASS_FAULT, TEST_ID_DEBOUNCED, 0u);
+        TEST_ASSERT(!status_is_fault_set(TEST_ID_DEBOUNCED));
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, TEST_ID_DEBOUNCED)
+                    == 0u);
+
+        status_source_set(STATUS_CLASS_FAULT, TEST_ID_DEBOUNCED, 1u);
+        TEST_ASSERT(status_is_fault_set(TEST_ID_DEBOUNCED));
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, TEST_ID_DEBOUNCED)
+                    == 0x02u);
+
+        status_source_clear(STATUS_CLASS_FAULT, TEST_ID_DEBOUNCED, 1u);
+        TEST_ASSERT(!status_is_fault_set(TEST_ID_DEBOUNCED));
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, TEST_ID_DEBOUNCED)
+                    == 0u);
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+#endif
+
+/*
+ * Priority ranks come straight from the table after status_init().
+ */
+static void
+test_priority_from_table(void)
+{
+        setUp();
+
+        status_set_fault(STATUS_ID_FAULT_MODULE_MISSING); /* 90 */
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_AFE);  /* 150 */
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_OVER_TEMP_AFE);
+
+        status_set_fault(TEST_ID_LATCHED); /* 252 */
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == TEST_ID_LATCHED);
+
+        status_set_warning(STATUS_ID_WARN_BROADCAST_LOSS);
+        status_set_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_WARNING)
+                    == STATUS_ID_WARN_CAN_LOAD_HIGH);
+
+        /* Runtime overrides apply until the next status_init(). */
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVER_TEMP_AFE,
+                            STATUS_PRIO_NONE);
+        status_ack(STATUS_CLASS_FAULT, TEST_ID_LATCHED);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_MODULE_MISSING);
+
+        status_init();
+        status_set_fault(STATUS_ID_FAULT_MODULE_MISSING);
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_AFE);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_OVER_TEMP_AFE);
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_accessors();
+        test_latch();
+        test_debounce();
+#if STATUS_ENABLE_SOURCES
+        test_debounce_with_sources();
+#endif
+        test_priority_from_table();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
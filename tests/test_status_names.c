@@ -0,0 +1,129 @@
+/*
+ * @file: test_status_names.c
+ * @brief Unit tests for the name <-> ID lookup.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "status.h"
+#include "status_ids_gen.h"
+#include "status_names.h"
+#include "test_harness.h"
+
+static bool
+lookup(const char *name, enum status_class *cls, uint16_t *id)
+{
+        return status_name_to_id(name, strlen(name), cls, id);
+}
+
+/*
+ * Every generated name resolves to its own class and ID.
+ */
+static void
+test_every_name_resolves(void)
+{
+        for (size_t i = 0u; i < STATUS_NAME_COUNT; ++i) {
+                const struct status_name_entry *e = &status_name_slots[i];
+                enum status_class cls = STATUS_CLASS_INFO;
+                uint16_t id = 0xFFFFu;
+
+                TEST_ASSERT(lookup(e->name, &cls, &id) == true);
+                TEST_ASSERT(cls == (enum status_class)e->cls);
+                TEST_ASSERT(id == e->id);
+        }
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * The STATUS_ID_ prefix is optional and names need not be NUL-terminated.
+ */
+static void
+test_prefix_and_length(void)
+{
+        enum status_class cls = STATUS_CLASS_INFO;
+        uint16_t id = 0u;
+        const char line[] = "FAULT_CAN_TIMEOUT clear";
+
+        TEST_ASSERT(lookup("STATUS_ID_WARN_FAN_PERF_DROP", &cls, &id) == true);
+        TEST_ASSERT(cls == STATUS_CLASS_WARNING);
+        TEST_ASSERT(id == STATUS_ID_WARN_FAN_PERF_DROP);
+
+        TEST_ASSERT(status_name_to_id(line, 17u, &cls, &id) == true);
+        TEST_ASSERT(cls == STATUS_CLASS_FAULT);
+        TEST_ASSERT(id == STATUS_ID_FAULT_CAN_TIMEOUT);
+
+        TEST_ASSERT(status_name_to_id(line, 5u, NULL, NULL) == false);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Unknown names, prefixes of names and NULL are rejected without touching
+ * the outputs.
+ */
+static void
+test_unknown_names(void)
+{
+        enum status_class cls = STATUS_CLASS_WARNING;
+        uint16_t id = 0x1234u;
+
+        TEST_ASSERT(lookup("FAULT_OVERCURRENTX", &cls, &id) == false);
+        TEST_ASSERT(lookup("FAULT_OVERCURREN", &cls, &id) == false);
+        TEST_ASSERT(lookup("fault_overcurrent", &cls, &id) == false);
+        TEST_ASSERT(lookup("", &cls, &id) == false);
+        TEST_ASSERT(lookup("STATUS_ID_", &cls, &id) == false);
+        TEST_ASSERT(status_name_to_id(NULL, 4u, &cls, &id) == false);
+
+        /* An embedded NUL is a character, not the end of the name. */
+        const char nul[] = "FAULT_OVERCURRENT\0junk";
+        TEST_ASSERT(status_name_to_id(nul, sizeof(nul) - 1u, &cls, &id)
+                    == false);
+        TEST_ASSERT(status_name_to_id(nul, 17u, NULL, NULL) == true);
+        TEST_ASSERT(cls == STATUS_CLASS_WARNING);
+        TEST_ASSERT(id == 0x1234u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Reverse lookup returns the name for defined IDs and NULL otherwise.
+ */
+static void
+test_id_to_name(void)
+{
+        TEST_ASSERT(strcmp(status_id_to_name(STATUS_CLASS_FAULT,
+                                             STATUS_ID_FAULT_OVERCURRENT),
+                           "FAULT_OVERCURRENT")
+                    == 0);
+        TEST_ASSERT(strcmp(status_id_to_name(STATUS_CLASS_INFO,
+                                             STATUS_ID_INFO_CAN_ACTIVE),
+                           "INFO_CAN_ACTIVE")
+                    == 0);
+        TEST_ASSERT(status_id_to_name(STATUS_CLASS_WARNING, 0u) == NULL);
+        TEST_ASSERT(status_id_to_name(STATUS_CLASS_FAULT,
+                                      STATUS_ENCODE(11u, 15u))
+                    == NULL);
+        TEST_ASSERT(status_id_to_name((enum status_class)7,
+                                      STATUS_ID_FAULT_OVERCURRENT)
+                    == NULL);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_every_name_resolves();
+        test_prefix_and_length();
+        test_unknown_names();
+        test_id_to_name();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
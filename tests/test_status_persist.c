@@ -0,0 +1,319 @@
+/*
+ * @file: test_status_persist.c
+ * @brief Unit tests for the append-only persistence log.
+ *
+ * @note Built with STATUS_ENABLE_DIRTY=1 and status_test_config.h.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "status.h"
+#include "status_ids.h"
+#include "status_persist.h"
+#include "test_harness.h"
+
+#define AREA_SIZE  (512u)
+#define COMPACT_AT (STATUS_PERSIST_SNAPSHOT_MAX + 96u)
+
+/* Emulated flash: writes only program erased bytes. */
+static uint8_t nvm[2][AREA_SIZE];
+static unsigned int writes_left; /* fail every write once this hits 0 */
+static unsigned int reads_left;  /* fail every read once this hits 0 */
+static unsigned int n_erases;
+
+static bool
+nvm_read(void *ctx, uint8_t area, uint32_t off, void *dst, size_t len)
+{
+        (void)ctx;
+        if ((area > 1u) || (off > AREA_SIZE) || (len > AREA_SIZE - off)
+            || (reads_left == 0u)) {
+                return false;
+        }
+        --reads_left;
+        memcpy(dst, &nvm[area][off], len);
+        return true;
+}
+
+static bool
+nvm_write(void *ctx, uint8_t area, uint32_t off, const void *src, size_t len)
+{
+        (void)ctx;
+        if ((area > 1u) || (off > AREA_SIZE) || (len > AREA_SIZE - off)
+            || (writes_left == 0u)) {
+                return false;
+        }
+        --writes_left;
+        for (size_t i = 0u; i < len; ++i) {
+                TEST_ASSERT(nvm[area][off + i] == 0xFFu);
+        }
+        memcpy(&nvm[area][off], src, len);
+        return true;
+}
+
+static bool
+nvm_erase(void *ctx, uint8_t area)
+{
+        (void)ctx;
+        if (area > 1u) {
+                return false;
+        }
+        memset(nvm[area], 0xFF, AREA_SIZE);
+        ++n_erases;
+        return true;
+}
+
+static const struct status_persist_cfg cfg = {
+        .read = nvm_read,
+        .write = nvm_write,
+        .erase = nvm_erase,
+        .ctx = NULL,
+        .area_size = AREA_SIZE,
+        .compact_at = COMPACT_AT,
+};
+
+/* Power-on: fresh register, then restore from the log. */
+static void
+reboot(void)
+{
+        status_init();
+        writes_left = ~0u;
+        reads_left = ~0u;
+        TEST_ASSERT(status_persist_open(&cfg));
+}
+
+static void
+setUp(void)
+{
+        memset(nvm, 0, sizeof(nvm)); /* neither erased nor formatted */
+        n_erases = 0u;
+        reboot();
+}
+
+static uint32_t
+lcg(uint32_t *s)
+{
+        *s = (*s * 1664525u) + 1013904223u;
+        return *s >> 8u;
+}
+
+/*
+ * Only changed banks are appended, one record each, and the state comes
+ * back after a reboot.
+ */
+static void
+test_append_and_restore(void)
+{
+        setUp();
+
+        const uint32_t base = status_persist_used();
+
+        TEST_ASSERT(base == 2u * STATUS_PERSIST_REC_SIZE);
+        TEST_ASSERT(status_persist_step(SIZE_MAX) == 0u);
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_set_fault(STATUS_ID_FAULT_OVERVOLTAGE); /* same bank */
+        status_set_warning(STATUS_ID_WARN_TEMP_NEAR_LIMIT);
+        status_set_info(STATUS_ID_FAULT_CAN_TIMEOUT);
+        status_clear_info(STATUS_ID_FAULT_CAN_TIMEOUT); /* still marked */
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);  /* no change */
+        TEST_ASSERT(status_persist_step(1u) == 1u);
+        TEST_ASSERT(status_persist_step(SIZE_MAX) == 2u);
+        TEST_ASSERT(status_persist_used()
+                    == base + (3u * STATUS_PERSIST_REC_SIZE));
+        TEST_ASSERT(status_persist_step(SIZE_MAX) == 0u);
+
+        status_clear_fault(STATUS_ID_FAULT_OVERVOLTAGE);
+        TEST_ASSERT(status_persist_sync());
+
+        reboot();
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        TEST_ASSERT(!status_is_fault_set(STATUS_ID_FAULT_OVERVOLTAGE));
+        TEST_ASSERT(status_is_warning_set(STATUS_ID_WARN_TEMP_NEAR_LIMIT));
+        TEST_ASSERT(!status_is_info_set(STATUS_ID_FAULT_CAN_TIMEOUT));
+        TEST_ASSERT(n_erases == 1u); /* formatted once, never compacted */
+
+        /* Restoring does not mark anything for the next append. */
+        TEST_ASSERT(status_persist_step(SIZE_MAX) == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Random churn: the log is compacted whenever it reaches the threshold,
+ * never grows past it by more than one step, and every reboot restores
+ * exactly the synced state.
+ */
+static void
+test_compaction(void)
+{
+        setUp();
+
+        uint32_t seed = 4242u;
+        uint16_t ref[3][NUM_STATUS_BANKS];
+        uint16_t got[NUM_STATUS_BANKS];
+
+        for (unsigned int round = 0u; round < 200u; ++round) {
+                for (unsigned int k = 0u; k < 5u; ++k) {
+                        const uint32_t r = lcg(&seed);
+                        const status_field_t bit = STATUS_FIELD(
+                            (r >> 4u) % NUM_STATUS_BANKS, r & 0x0Fu, 1u);
+
+                        status_field_set((enum status_class)((r >> 12u) % 3u),
+                                         bit, (uint16_t)((r >> 16u) & 1u));
+                }
+                /* A small budget spreads compactions over several steps. */
+                (void)status_persist_step(8u);
+                TEST_ASSERT(status_persist_used()
+                            <= COMPACT_AT + (8u * STATUS_PERSIST_REC_SIZE));
+        }
+        TEST_ASSERT(n_erases > 3u);
+        TEST_ASSERT(status_persist_sync());
+        TEST_ASSERT(status_persist_used() < COMPACT_AT);
+
+        for (unsigned int c = 0u; c < 3u; ++c) {
+                status_snapshot((enum status_class)c, ref[c], NUM_STATUS_BANKS);
+        }
+        reboot();
+        for (unsigned int c = 0u; c < 3u; ++c) {
+                status_snapshot((enum status_class)c, got, NUM_STATUS_BANKS);
+                TEST_ASSERT(memcmp(got, ref[c], sizeof(got)) == 0);
+        }
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A reset in the middle of a record or of a compaction loses only what was
+ * not yet stored.
+ */
+static void
+test_power_loss(void)
+{
+        setUp();
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(status_persist_sync());
+
+        /* Torn record: its CRC no longer matches. */
+        const uint32_t end = status_persist_used();
+
+        status_set_warning(STATUS_ID_WARN_TEMP_NEAR_LIMIT);
+        TEST_ASSERT(status_persist_sync());
+        nvm[0][end + 5u] ^= 0x01u;
+        reboot();
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        TEST_ASSERT(!status_is_warning_set(STATUS_ID_WARN_TEMP_NEAR_LIMIT));
+
+        /* The torn tail is compacted away before anything is appended. */
+        status_set_info(STATUS_ID_FAULT_CAN_TIMEOUT);
+        TEST_ASSERT(status_persist_sync());
+        TEST_ASSERT(status_persist_used() == 4u * STATUS_PERSIST_REC_SIZE);
+        reboot();
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        TEST_ASSERT(status_is_info_set(STATUS_ID_FAULT_CAN_TIMEOUT));
+
+        /* Reset during compaction: header written, commit never reached. */
+        for (uint16_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                status_set_warning(STATUS_ENCODE(b, 3u));
+        }
+        TEST_ASSERT(status_persist_sync());
+        while (status_persist_used() + STATUS_PERSIST_REC_SIZE
+               < COMPACT_AT) {
+                status_set_warning(STATUS_ENCODE(0u, 1u));
+                TEST_ASSERT(status_persist_step(SIZE_MAX) == 1u);
+                status_clear_warning(STATUS_ENCODE(0u, 1u));
+                TEST_ASSERT(status_persist_step(SIZE_MAX) == 1u);
+        }
+        /* Only in the snapshot being written when the reset hits. */
+        status_set_fault(STATUS_ENCODE(5u, 5u));
+        writes_left = 3u;
+        TEST_ASSERT(status_persist_step(2u) == 2u);
+        TEST_ASSERT(!status_persist_sync());
+        reboot();
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        TEST_ASSERT(!status_is_fault_set(STATUS_ENCODE(5u, 5u)));
+        TEST_ASSERT(status_is_warning_set(STATUS_ENCODE(7u, 3u)));
+        TEST_ASSERT(!status_is_warning_set(STATUS_ENCODE(0u, 1u)));
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A read error at power-on, in a header or in the log, fails the open and
+ * leaves the storage untouched instead of formatting it.
+ */
+static void
+test_read_error_keeps_log(void)
+{
+        static uint8_t before[2][AREA_SIZE];
+
+        setUp();
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(status_persist_sync());
+        memcpy(before, nvm, sizeof(nvm));
+
+        const unsigned int erases = n_erases;
+
+        for (unsigned int ok_reads = 0u; ok_reads < 3u; ++ok_reads) {
+                status_init();
+                writes_left = ~0u;
+                reads_left = ok_reads;
+                TEST_ASSERT(!status_persist_open(&cfg));
+                TEST_ASSERT(n_erases == erases);
+                TEST_ASSERT(memcmp(nvm, before, sizeof(nvm)) == 0);
+                TEST_ASSERT(status_persist_step(SIZE_MAX) == 0u);
+        }
+
+        reboot();
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        TEST_ASSERT(n_erases == erases);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Bad geometry and missing callbacks are rejected; a closed log does
+ * nothing.
+ */
+static void
+test_invalid_cfg(void)
+{
+        setUp();
+
+        struct status_persist_cfg bad = cfg;
+
+        bad.compact_at = STATUS_PERSIST_SNAPSHOT_MAX;
+        TEST_ASSERT(!status_persist_open(&bad));
+        bad = cfg;
+        bad.compact_at = AREA_SIZE + 1u;
+        TEST_ASSERT(!status_persist_open(&bad));
+        bad = cfg;
+        bad.erase = NULL;
+        TEST_ASSERT(!status_persist_open(&bad));
+        TEST_ASSERT(!status_persist_open(NULL));
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(status_persist_step(SIZE_MAX) == 0u);
+        TEST_ASSERT(!status_persist_sync());
+        TEST_ASSERT(status_persist_used() == 0u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_append_and_restore();
+        test_compaction();
+        test_power_loss();
+        test_read_error_keeps_log();
+        test_invalid_cfg();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
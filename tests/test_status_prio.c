@@ -0,0 +1,204 @@
+/*
+ * @file: test_status_prio.c
+ * @brief Unit tests for the priority-indexed highest-active query.
+ *
+ * @note Built with STATUS_ENABLE_PRIORITY=1 and status_test_config.h.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "status.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+static status_err_t g_last_err;
+static unsigned int g_err_count;
+
+static void
+test_err_cb(status_err_t err, uint16_t id)
+{
+        (void)id;
+        g_last_err = err;
+        ++g_err_count;
+}
+
+static void
+setUp(void)
+{
+        status_init();
+        status_set_err_callback(test_err_cb);
+        g_err_count = 0u;
+        for (uint16_t i = 0u; i < (uint16_t)(NUM_STATUS_BANKS * NUM_STATUS_BITS);
+             ++i) {
+                status_set_priority(STATUS_CLASS_FAULT, i, STATUS_PRIO_NONE);
+        }
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVERCURRENT,
+                            200u);
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVER_TEMP_INV,
+                            100u);
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_CAN_TIMEOUT,
+                            5u);
+}
+
+/*
+ * The highest-ranked active ID wins; clearing it exposes the next one.
+ */
+static void
+test_highest_follows_edges(void)
+{
+        setUp();
+
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_UNSET_ID);
+
+        status_set_fault(STATUS_ID_FAULT_CAN_TIMEOUT);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_CAN_TIMEOUT);
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_INV);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_OVERCURRENT);
+
+        status_clear_fault(STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_OVER_TEMP_INV);
+
+        status_clear_all(STATUS_CLASS_FAULT);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_UNSET_ID);
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Unranked IDs are ignored, and classes are independent.
+ */
+static void
+test_unranked_and_class_isolation(void)
+{
+        setUp();
+
+        status_set_fault(STATUS_ID_FAULT_DC_BUS_FAULT);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_UNSET_ID);
+
+        status_set_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_WARNING)
+                    == STATUS_UNSET_ID);
+
+        /* Warning bank 0 bit 0 shares its index with OVERCURRENT. */
+        status_set_warning(STATUS_ENCODE(0u, 0u));
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_UNSET_ID);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Re-ranking an active ID moves it in the bitmap immediately.
+ */
+static void
+test_rerank_active_id(void)
+{
+        setUp();
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_set_fault(STATUS_ID_FAULT_OVER_TEMP_INV);
+
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVERCURRENT,
+                            1u);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_OVER_TEMP_INV);
+
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVER_TEMP_INV,
+                            STATUS_PRIO_NONE);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_OVERCURRENT);
+
+        /* The freed rank can be reused by another ID. */
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_DC_BUS_FAULT,
+                            100u);
+        status_set_fault(STATUS_ID_FAULT_DC_BUS_FAULT);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_DC_BUS_FAULT);
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Ranks at both ends of the range and across level words work, including
+ * ID 0 at rank 0.
+ */
+static void
+test_rank_extremes(void)
+{
+        setUp();
+
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVERCURRENT,
+                            0u);
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_OVERCURRENT);
+
+        uint16_t top = STATUS_ENCODE((uint16_t)(NUM_STATUS_BANKS - 1u), 15u);
+        status_set_priority(STATUS_CLASS_FAULT, top,
+                            (uint16_t)(STATUS_PRIO_LEVELS - 1u));
+        status_set_fault(top);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT) == top);
+
+        status_set_fault(STATUS_ID_FAULT_CAN_TIMEOUT); /* rank 5 */
+        status_clear_fault(top);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_ID_FAULT_CAN_TIMEOUT);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Duplicate and out-of-range ranks are rejected.
+ */
+static void
+test_invalid_ranks(void)
+{
+        setUp();
+
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_DC_BUS_FAULT,
+                            200u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+        status_set_fault(STATUS_ID_FAULT_DC_BUS_FAULT);
+        TEST_ASSERT(status_highest_active(STATUS_CLASS_FAULT)
+                    == STATUS_UNSET_ID);
+
+        status_set_priority(STATUS_CLASS_FAULT, STATUS_ID_FAULT_DC_BUS_FAULT,
+                            (uint16_t)STATUS_PRIO_LEVELS);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+        status_set_priority(STATUS_CLASS_FAULT,
+                            STATUS_ENCODE((uint16_t)NUM_STATUS_BANKS, 0u), 1u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        TEST_ASSERT(status_highest_active((enum status_class)99)
+                    == STATUS_UNSET_ID);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ID);
+        TEST_ASSERT(g_err_count == 4u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_highest_follows_edges();
+        test_unranked_and_class_isolation();
+        test_rerank_active_id();
+        test_rank_extremes();
+        test_invalid_ranks();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
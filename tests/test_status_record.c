@@ -0,0 +1,114 @@
+/*
+ * @file: test_status_record.c
+ * @brief Unit tests for the dump / recording format helpers.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Provide no-op critical sections for host-side testing. */
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#include "status.h"
+#include "status_ids.h"
+#include "status_record.h"
+#include "test_harness.h"
+
+/*
+ * Records survive a pack/unpack round trip and are little-endian on disk.
+ */
+static void
+test_record_roundtrip(void)
+{
+        const struct status_record in = {
+                .time = 0x01020304u,
+                .id = STATUS_ID_WARN_BROADCAST_LOSS,
+                .cls = (uint8_t)STATUS_CLASS_WARNING,
+                .op = (uint8_t)STATUS_REC_SET,
+                .value = 0xA0B0C0D0u,
+        };
+        struct status_record out;
+        uint8_t buf[STATUS_REC_SIZE];
+
+        status_record_pack(buf, &in);
+        TEST_ASSERT(buf[0] == 0x04u);
+        TEST_ASSERT(buf[3] == 0x01u);
+        TEST_ASSERT(buf[4] == (uint8_t)STATUS_ID_WARN_BROADCAST_LOSS);
+        TEST_ASSERT(buf[8] == 0xD0u);
+
+        status_record_unpack(&out, buf);
+        TEST_ASSERT(out.time == in.time);
+        TEST_ASSERT(out.id == in.id);
+        TEST_ASSERT(out.cls == in.cls);
+        TEST_ASSERT(out.op == in.op);
+        TEST_ASSERT(out.value == in.value);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Headers carry the magic, version and bank count.
+ */
+static void
+test_headers(void)
+{
+        uint8_t rec[STATUS_REC_HDR_SIZE];
+        uint8_t dump[STATUS_DUMP_HDR_SIZE];
+
+        status_rec_header_pack(rec, (uint16_t)NUM_STATUS_BANKS);
+        TEST_ASSERT(memcmp(rec, "STRC", 4u) == 0);
+        TEST_ASSERT(status_le16_get(&rec[4]) == STATUS_REC_VERSION);
+        TEST_ASSERT(status_le16_get(&rec[6]) == NUM_STATUS_BANKS);
+        TEST_ASSERT(status_le32_get(&rec[8]) == STATUS_REC_SIZE);
+
+        status_dump_header_pack(dump, 7u);
+        TEST_ASSERT(memcmp(dump, "STDP", 4u) == 0);
+        TEST_ASSERT(status_le16_get(&dump[6]) == 7u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * The checkpoint hash follows the register contents.
+ */
+static void
+test_checkpoint_hash(void)
+{
+        uint16_t banks[NUM_STATUS_BANKS];
+        uint32_t empty;
+        uint32_t h;
+
+        status_init();
+        status_snapshot(STATUS_CLASS_FAULT, banks, NUM_STATUS_BANKS);
+        empty = status_record_hash(banks, NUM_STATUS_BANKS,
+                                   STATUS_REC_HASH_INIT);
+
+        status_set_fault(STATUS_ID_FAULT_CAN_TIMEOUT);
+        status_snapshot(STATUS_CLASS_FAULT, banks, NUM_STATUS_BANKS);
+        h = status_record_hash(banks, NUM_STATUS_BANKS, STATUS_REC_HASH_INIT);
+        TEST_ASSERT(h != empty);
+
+        status_clear_fault(STATUS_ID_FAULT_CAN_TIMEOUT);
+        status_snapshot(STATUS_CLASS_FAULT, banks, NUM_STATUS_BANKS);
+        TEST_ASSERT(status_record_hash(banks, NUM_STATUS_BANKS,
+                                       STATUS_REC_HASH_INIT)
+                    == empty);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_record_roundtrip();
+        test_headers();
+        test_checkpoint_hash();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
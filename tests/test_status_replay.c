@@ -0,0 +1,236 @@
+/*
+ * @file: test_status_replay.c
+ * @brief Unit tests for recording replay.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Provide no-op critical sections for host-side testing. */
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+
+#include "status.h"
+#include "status_ids.h"
+#include "status_record.h"
+#include "status_replay.h"
+#include "test_harness.h"
+
+#define MAX_RECORDS (16u)
+
+static uint8_t rec_buf[STATUS_REC_HDR_SIZE + (MAX_RECORDS * STATUS_REC_SIZE)];
+static size_t rec_len;
+
+static void
+rec_begin(void)
+{
+        status_rec_header_pack(rec_buf, (uint16_t)NUM_STATUS_BANKS);
+        rec_len = STATUS_REC_HDR_SIZE;
+}
+
+static void
+rec_add(uint32_t time, enum status_rec_op op, enum status_class cls,
+        uint16_t id, uint32_t value)
+{
+        const struct status_record r = {
+                .time = time,
+                .id = id,
+                .cls = (uint8_t)cls,
+                .op = (uint8_t)op,
+                .value = value,
+        };
+
+        status_record_pack(&rec_buf[rec_len], &r);
+        rec_len += STATUS_REC_SIZE;
+}
+
+/*
+ * Replaying a live session reproduces its final state and checkpoints.
+ */
+static void
+test_replay_reproduces_state(void)
+{
+        struct status_replay_result res;
+        uint32_t cp1;
+        uint32_t cp2;
+        uint16_t faults[NUM_STATUS_BANKS];
+
+        /* Record a session by hand, taking checkpoints from the live state. */
+        status_init();
+        rec_begin();
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        rec_add(10u, STATUS_REC_SET, STATUS_CLASS_FAULT,
+                STATUS_ID_FAULT_OVERCURRENT, 0u);
+        status_set_warning(STATUS_ID_WARN_FAN_PERF_DROP);
+        rec_add(20u, STATUS_REC_SET, STATUS_CLASS_WARNING,
+                STATUS_ID_WARN_FAN_PERF_DROP, 0u);
+        cp1 = status_replay_checkpoint();
+        rec_add(25u, STATUS_REC_CHECKPOINT, STATUS_CLASS_FAULT, 0u, cp1);
+        status_clear_all(STATUS_CLASS_WARNING);
+        rec_add(30u, STATUS_REC_CLEAR_ALL, STATUS_CLASS_WARNING, 0u, 0u);
+        status_set_fault(STATUS_ID_FAULT_CAN_TIMEOUT);
+        rec_add(40u, STATUS_REC_SET, STATUS_CLASS_FAULT,
+                STATUS_ID_FAULT_CAN_TIMEOUT, 0u);
+        status_clear_fault(STATUS_ID_FAULT_OVERCURRENT);
+        rec_add(50u, STATUS_REC_CLEAR, STATUS_CLASS_FAULT,
+                STATUS_ID_FAULT_OVERCURRENT, 0u);
+        cp2 = status_replay_checkpoint();
+        rec_add(60u, STATUS_REC_CHECKPOINT, STATUS_CLASS_FAULT, 0u, cp2);
+        TEST_ASSERT(cp1 != cp2);
+
+        status_init();
+        TEST_ASSERT(status_replay(rec_buf, rec_len, NULL, NULL, &res));
+        TEST_ASSERT(res.events == 7u);
+        TEST_ASSERT(res.checkpoints == 2u);
+        TEST_ASSERT(res.mismatches == 0u);
+        TEST_ASSERT(res.invalid == 0u);
+        TEST_ASSERT(res.first_mismatch == SIZE_MAX);
+
+        status_snapshot(STATUS_CLASS_FAULT, faults, NUM_STATUS_BANKS);
+        TEST_ASSERT(faults[0] == 0u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_CAN_TIMEOUT));
+        TEST_ASSERT(!status_any(STATUS_CLASS_WARNING));
+        TEST_ASSERT(status_last_fault() == STATUS_ID_FAULT_CAN_TIMEOUT);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A diverging state is reported at the first failing checkpoint.
+ */
+static void
+test_replay_detects_mismatch(void)
+{
+        struct status_replay_result res;
+
+        rec_begin();
+        rec_add(1u, STATUS_REC_SET, STATUS_CLASS_INFO,
+                STATUS_ID_INFO_AC_LIVE, 0u);
+        rec_add(2u, STATUS_REC_CHECKPOINT, STATUS_CLASS_FAULT, 0u,
+                0x12345678u);
+        rec_add(3u, STATUS_REC_CHECKPOINT, STATUS_CLASS_FAULT, 0u,
+                0x12345678u);
+        rec_add(4u, 0x7Fu, STATUS_CLASS_INFO, 0u, 0u);
+        rec_add(5u, STATUS_REC_SET, (enum status_class)9, 0u, 0u);
+
+        status_init();
+        TEST_ASSERT(status_replay(rec_buf, rec_len, NULL, NULL, &res));
+        TEST_ASSERT(res.checkpoints == 2u);
+        TEST_ASSERT(res.mismatches == 2u);
+        TEST_ASSERT(res.first_mismatch == 1u);
+        TEST_ASSERT(res.invalid == 2u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A set or clear of an ID past the last bank is invalid and never reaches
+ * the API's error callback.
+ */
+static unsigned int cb_calls;
+
+static void
+count_cb(status_err_t err, uint16_t id)
+{
+        (void)err;
+        (void)id;
+        ++cb_calls;
+}
+
+static void
+test_replay_rejects_bank(void)
+{
+        struct status_replay_result res;
+        const uint16_t bad = STATUS_ENCODE(NUM_STATUS_BANKS, 0u);
+
+        rec_begin();
+        rec_add(1u, STATUS_REC_SET, STATUS_CLASS_FAULT, bad, 0u);
+        rec_add(2u, STATUS_REC_CLEAR, STATUS_CLASS_WARNING, bad, 0u);
+        rec_add(3u, STATUS_REC_SET, STATUS_CLASS_FAULT,
+                STATUS_ID_FAULT_OVERCURRENT, 0u);
+
+        status_init();
+        cb_calls = 0u;
+        status_set_err_callback(count_cb);
+        TEST_ASSERT(status_replay(rec_buf, rec_len, NULL, NULL, &res));
+        TEST_ASSERT(res.events == 3u);
+        TEST_ASSERT(res.invalid == 2u);
+        TEST_ASSERT(cb_calls == 0u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        status_set_err_callback(NULL);
+
+        TEST_PASS(__func__);
+}
+
+static status_time_t waited[MAX_RECORDS];
+static size_t wait_calls;
+
+static void
+record_wait(status_time_t delta, void *ctx)
+{
+        TEST_ASSERT(ctx == (void *)&wait_calls);
+        waited[wait_calls++] = delta;
+}
+
+/*
+ * The pacing hook sees the recorded gaps, including across a clock wrap.
+ */
+static void
+test_replay_pacing(void)
+{
+        struct status_replay_result res;
+
+        rec_begin();
+        rec_add(0xFFFFFFF0u, STATUS_REC_SET, STATUS_CLASS_FAULT, 0u, 0u);
+        rec_add(0xFFFFFFFAu, STATUS_REC_CLEAR, STATUS_CLASS_FAULT, 0u, 0u);
+        rec_add(0x00000004u, STATUS_REC_SET, STATUS_CLASS_FAULT, 0u, 0u);
+
+        status_init();
+        wait_calls = 0u;
+        TEST_ASSERT(status_replay(rec_buf, rec_len, record_wait, &wait_calls,
+                                  &res));
+        TEST_ASSERT(wait_calls == 3u);
+        TEST_ASSERT(waited[0] == 0u);
+        TEST_ASSERT(waited[1] == 10u);
+        TEST_ASSERT(waited[2] == 10u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Recordings from a differently configured build are refused.
+ */
+static void
+test_replay_rejects_header(void)
+{
+        struct status_replay_result res;
+
+        rec_begin();
+        rec_add(1u, STATUS_REC_SET, STATUS_CLASS_FAULT, 0u, 0u);
+        status_le16_put(&rec_buf[6], (uint16_t)(NUM_STATUS_BANKS + 1u));
+
+        status_init();
+        TEST_ASSERT(!status_replay(rec_buf, rec_len, NULL, NULL, &res));
+        TEST_ASSERT(!status_any(STATUS_CLASS_FAULT));
+        TEST_ASSERT(!status_replay(rec_buf, 4u, NULL, NULL, &res));
+        TEST_ASSERT(!status_replay(NULL, rec_len, NULL, NULL, &res));
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_replay_reproduces_state();
+        test_replay_detects_mismatch();
+        test_replay_rejects_bank();
+        test_replay_pacing();
+        test_replay_rejects_header();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
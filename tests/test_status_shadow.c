@@ -0,0 +1,257 @@
+/*
+ * @file: test_status_shadow.c
+ * @brief Unit tests for the complement shadow banks and the scrubber.
+ *
+ * @note Includes status.c directly so that the tests can corrupt either copy
+ *       behind the API's back. Built with STATUS_ENABLE_SHADOW=1,
+ *       STATUS_ENABLE_INTEGRITY=1 and STATUS_ENABLE_BANK_ALLOC=1.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/status.c"
+#include "status_ids.h"
+#include "test_harness.h"
+
+static unsigned int integrity_errs;
+static uint16_t last_err_id;
+
+static void
+count_err(status_err_t err, uint16_t id)
+{
+        if (err == STATUS_ERR_INTEGRITY) {
+                ++integrity_errs;
+                last_err_id = id;
+        }
+}
+
+static void
+setUp(void)
+{
+        status_init();
+        status_set_err_callback(count_err);
+        integrity_errs = 0u;
+        last_err_id = STATUS_UNSET_ID;
+}
+
+/* Scrub every bank of every class exactly once. */
+static size_t
+full_scrub(void)
+{
+        return status_scrub_step(SCRUB_SPAN);
+}
+
+/*
+ * API traffic keeps primary == ~shadow, so a full scrub repairs nothing.
+ */
+static void
+test_api_traffic_consistent(void)
+{
+        setUp();
+
+        for (uint16_t b = 0u; b < NUM_STATUS_BANKS; ++b) {
+                status_set_fault(STATUS_ENCODE(b, (uint16_t)(b % 16u)));
+                status_set_info(STATUS_ENCODE(b, 0u));
+        }
+        status_clear_fault(STATUS_ENCODE(2u, 2u));
+        status_clear_all(STATUS_CLASS_INFO);
+        status_set_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+
+        TEST_ASSERT(full_scrub() == 0u);
+        TEST_ASSERT(integrity_errs == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A dropped bit in the primary is restored from the shadow.
+ */
+static void
+test_primary_flip_repaired(void)
+{
+        setUp();
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+
+        fault_banks[status_bank(STATUS_ID_FAULT_OVERCURRENT)] = 0u;
+        TEST_ASSERT(!status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+
+        TEST_ASSERT(full_scrub() == 1u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        TEST_ASSERT(integrity_errs == 1u);
+        TEST_ASSERT(last_err_id == STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(full_scrub() == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A flipped shadow bit is repaired without clearing an active status; a
+ * shadow bit claiming an extra status raises it (fault-preserving bias).
+ */
+static void
+test_shadow_flip_repaired(void)
+{
+        const uint16_t bank = status_bank(STATUS_ID_WARN_CAN_LOAD_HIGH);
+        const uint16_t bit = status_bit(STATUS_ID_WARN_CAN_LOAD_HIGH);
+
+        setUp();
+        status_set_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+
+        shadow_banks[STATUS_CLASS_WARNING][bank] ^= (uint16_t)(1u << bit);
+        TEST_ASSERT(full_scrub() == 1u);
+        TEST_ASSERT(status_is_warning_set(STATUS_ID_WARN_CAN_LOAD_HIGH));
+        TEST_ASSERT(full_scrub() == 0u);
+
+        shadow_banks[STATUS_CLASS_WARNING][bank] ^=
+            (uint16_t)(1u << ((bit + 1u) % 16u));
+        TEST_ASSERT(full_scrub() == 1u);
+        TEST_ASSERT(status_is_warning_set(
+            STATUS_ENCODE(bank, (uint16_t)((bit + 1u) % 16u))));
+        TEST_ASSERT(full_scrub() == 0u);
+        TEST_ASSERT(integrity_errs == 2u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A write to another bit of a corrupted bank must not copy the corruption
+ * into the shadow: the lost fault survives the write and is reported.
+ */
+static void
+test_write_after_corruption(void)
+{
+        setUp();
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+
+        fault_banks[status_bank(STATUS_ID_FAULT_OVERCURRENT)] = 0u;
+        status_set_fault(STATUS_ID_FAULT_OVERVOLTAGE); /* same bank */
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+
+        fault_banks[status_bank(STATUS_ID_FAULT_OVERCURRENT)] &=
+            (uint16_t)~1u;
+        status_clear_fault(STATUS_ID_FAULT_OVERVOLTAGE);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        TEST_ASSERT(!status_is_fault_set(STATUS_ID_FAULT_OVERVOLTAGE));
+        TEST_ASSERT(integrity_errs == 0u);
+
+        TEST_ASSERT(full_scrub() == 2u);
+        TEST_ASSERT(integrity_errs == 1u);
+        TEST_ASSERT(last_err_id == STATUS_ID_FAULT_OVERCURRENT);
+        TEST_ASSERT(full_scrub() == 0u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Clearing a bank whose primary already lost its bit also resets the
+ * stale shadow, so the next scrub cannot bring the status back.
+ */
+static void
+test_clear_after_corruption(void)
+{
+        const uint16_t bank = status_bank(STATUS_ID_FAULT_OVERCURRENT);
+
+        setUp();
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+
+        fault_banks[bank] = 0u;
+        status_clear_all(STATUS_CLASS_FAULT);
+        TEST_ASSERT(full_scrub() == 1u);
+        TEST_ASSERT(integrity_errs == 1u);
+        TEST_ASSERT(!status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        TEST_ASSERT(full_scrub() == 0u);
+
+        /* Same through freeing the bank. */
+        TEST_ASSERT(status_bank_alloc(1u, 1u) == 0u);
+        status_set_warning(STATUS_ENCODE(0u, 4u));
+        warning_banks[0] = 0u;
+        status_bank_free(0u, 1u, 1u);
+        TEST_ASSERT(full_scrub() == 1u);
+        TEST_ASSERT(!status_is_warning_set(STATUS_ENCODE(0u, 4u)));
+        TEST_ASSERT(full_scrub() == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/* One full background verification pass of a class. */
+static bool
+verify_pass(enum status_class cls)
+{
+        return status_verify_step(cls, NUM_STATUS_BANKS);
+}
+
+/*
+ * Repairs, by the scrubber or by a write, take their delta from the value
+ * last written, so the checksum still matches the repaired register.
+ */
+static void
+test_repair_keeps_checksum(void)
+{
+        const uint16_t bank = status_bank(STATUS_ID_FAULT_OVERCURRENT);
+
+        setUp();
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+
+        fault_banks[bank] = 0u;
+        TEST_ASSERT(full_scrub() == 1u);
+        for (unsigned int pass = 0u; pass < 3u; ++pass) {
+                TEST_ASSERT(verify_pass(STATUS_CLASS_FAULT));
+        }
+
+        fault_banks[bank] = 0u;
+        status_set_fault(STATUS_ID_FAULT_OVERVOLTAGE); /* same bank */
+        TEST_ASSERT(verify_pass(STATUS_CLASS_FAULT));
+
+        /* An upset raising a bit is kept, and counted as a new set. */
+        fault_banks[bank] |= 0x8000u;
+        TEST_ASSERT(full_scrub() == 2u);
+        TEST_ASSERT(status_is_fault_set(STATUS_ENCODE(bank, 15u)));
+        TEST_ASSERT(verify_pass(STATUS_CLASS_FAULT));
+        TEST_ASSERT(status_verify(STATUS_CLASS_FAULT));
+        TEST_ASSERT(integrity_errs == 3u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * The cursor rotates across classes: corruption in the last bank of the
+ * info class is reached only after every earlier bank has been visited.
+ */
+static void
+test_cursor_rotates(void)
+{
+        setUp();
+
+        info_banks[NUM_STATUS_BANKS - 1u] = 0x8000u;
+        TEST_ASSERT(status_scrub_step(SCRUB_SPAN - 1u) == 0u);
+        TEST_ASSERT(status_scrub_step(1u) == 1u);
+        TEST_ASSERT(last_err_id
+                    == STATUS_ENCODE((uint16_t)(NUM_STATUS_BANKS - 1u), 15u));
+
+        /* Wrapped back to the first fault bank. */
+        fault_banks[0] = 1u;
+        TEST_ASSERT(status_scrub_step(1u) == 1u);
+        TEST_ASSERT(status_scrub_step(0u) == 0u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_api_traffic_consistent();
+        test_primary_flip_repaired();
+        test_shadow_flip_repaired();
+        test_write_after_corruption();
+        test_clear_after_corruption();
+        test_repair_keeps_checksum();
+        test_cursor_rotates();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
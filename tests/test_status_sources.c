@@ -0,0 +1,144 @@
+/*
+ * @file: test_status_sources.c
+ * @brief Unit tests for multi-source status IDs.
+ *
+ * @note Built with STATUS_ENABLE_SOURCES=1 and status_test_config.h.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "status.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+static status_err_t g_last_err;
+static unsigned int g_err_count;
+
+static void
+test_err_cb(status_err_t err, uint16_t id)
+{
+        (void)id;
+        g_last_err = err;
+        ++g_err_count;
+}
+
+static void
+setUp(void)
+{
+        status_init();
+        status_set_err_callback(test_err_cb);
+        status_set_err_rate_limit(1u);
+        g_err_count = 0u;
+}
+
+/*
+ * Three sensors assert the same fault; it stays set until the last one
+ * releases it.
+ */
+static void
+test_clears_on_last_release(void)
+{
+        setUp();
+
+        const uint16_t id = STATUS_ID_FAULT_OVERCURRENT;
+
+        status_source_set(STATUS_CLASS_FAULT, id, 0u);
+        status_source_set(STATUS_CLASS_FAULT, id, 1u);
+        status_source_set(STATUS_CLASS_FAULT, id, 7u);
+        status_source_set(STATUS_CLASS_FAULT, id, 1u); /* idempotent */
+        TEST_ASSERT(status_is_fault_set(id));
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, id) == 0x83u);
+
+        status_source_clear(STATUS_CLASS_FAULT, id, 1u);
+        status_source_clear(STATUS_CLASS_FAULT, id, 1u);
+        status_source_clear(STATUS_CLASS_FAULT, id, 3u); /* never asserted */
+        status_source_clear(STATUS_CLASS_FAULT, id, 0u);
+        TEST_ASSERT(status_is_fault_set(id));
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, id) == 0x80u);
+
+        status_source_clear(STATUS_CLASS_FAULT, id, 7u);
+        TEST_ASSERT(!status_is_fault_set(id));
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, id) == 0u);
+
+        /* Same ID in another class is tracked separately. */
+        status_source_set(STATUS_CLASS_WARNING, id, 2u);
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, id) == 0u);
+        TEST_ASSERT(status_is_warning_set(id) && !status_is_fault_set(id));
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * A plain clear overrides every source and drops them all, so a later
+ * source assert starts from a clean slate.
+ */
+static void
+test_plain_clear_drops_sources(void)
+{
+        setUp();
+
+        const uint16_t id = STATUS_ID_FAULT_CAN_TIMEOUT;
+
+        status_source_set(STATUS_CLASS_FAULT, id, 0u);
+        status_source_set(STATUS_CLASS_FAULT, id, 1u);
+        status_clear_fault(id);
+        TEST_ASSERT(!status_is_fault_set(id));
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, id) == 0u);
+
+        status_source_set(STATUS_CLASS_FAULT, id, 1u);
+        status_clear_all(STATUS_CLASS_FAULT);
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, id) == 0u);
+
+        status_source_set(STATUS_CLASS_FAULT, id, 2u);
+        status_source_clear(STATUS_CLASS_FAULT, id, 2u);
+        TEST_ASSERT(!status_is_fault_set(id));
+
+        /* A plain set has no source; a source release cannot clear it. */
+        status_set_fault(id);
+        status_source_clear(STATUS_CLASS_FAULT, id, 0u);
+        TEST_ASSERT(status_is_fault_set(id));
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Bad arguments are reported and change nothing.
+ */
+static void
+test_invalid_args(void)
+{
+        setUp();
+
+        const uint16_t bad_id = STATUS_ENCODE((uint16_t)NUM_STATUS_BANKS, 0u);
+
+        status_source_set(STATUS_CLASS_FAULT, STATUS_ID_FAULT_OVERCURRENT,
+                          (uint8_t)STATUS_SOURCES_MAX);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ARG);
+        TEST_ASSERT(!status_is_fault_set(STATUS_ID_FAULT_OVERCURRENT));
+        status_source_clear(STATUS_CLASS_FAULT, bad_id, 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_BANK);
+        status_source_set((enum status_class)9, STATUS_ID_FAULT_OVERCURRENT,
+                          0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ID);
+        TEST_ASSERT(g_err_count == 3u);
+        TEST_ASSERT(status_source_mask(STATUS_CLASS_FAULT, bad_id) == 0u);
+        TEST_ASSERT(status_source_mask((enum status_class)9, 0u) == 0u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_clears_on_last_release();
+        test_plain_clear_drops_sources();
+        test_invalid_args();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
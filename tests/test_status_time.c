@@ -0,0 +1,210 @@
+/*
+ * @file: test_status_time.c
+ * @brief Unit tests for time-in-state accumulation.
+ *
+ * @note Built with STATUS_ENABLE_TIME_IN_STATE=1 and status_test_config.h.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "status.h"
+#include "status_ids.h"
+#include "test_harness.h"
+
+static status_err_t g_last_err;
+static unsigned int g_err_count;
+
+static void
+test_err_cb(status_err_t err, uint16_t id)
+{
+        (void)id;
+        g_last_err = err;
+        ++g_err_count;
+}
+
+static void
+setUp(void)
+{
+        status_test_clock = 1000u;
+        status_init();
+        status_set_err_callback(test_err_cb);
+        g_err_count = 0u;
+}
+
+/*
+ * Closed intervals accumulate; idle time in between does not count.
+ */
+static void
+test_accumulates_closed_intervals(void)
+{
+        setUp();
+
+        status_time_t acc[NUM_STATUS_BANKS * NUM_STATUS_BITS];
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_test_clock += 10u;
+        status_clear_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_test_clock += 100u;
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_test_clock += 5u;
+        status_clear_fault(STATUS_ID_FAULT_OVERCURRENT);
+
+        status_time_in_state(STATUS_CLASS_FAULT, acc,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+        TEST_ASSERT(acc[STATUS_ID_FAULT_OVERCURRENT] == 15u);
+        TEST_ASSERT(acc[STATUS_ID_FAULT_OVERVOLTAGE] == 0u);
+        TEST_ASSERT(g_err_count == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Re-setting an active bit is not an edge and must not restart its interval.
+ */
+static void
+test_repeated_set_is_not_an_edge(void)
+{
+        setUp();
+
+        status_time_t acc[NUM_STATUS_BANKS * NUM_STATUS_BITS];
+
+        status_set_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+        status_test_clock += 7u;
+        status_set_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+        status_test_clock += 3u;
+        status_clear_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+        status_clear_warning(STATUS_ID_WARN_CAN_LOAD_HIGH);
+
+        status_time_in_state(STATUS_CLASS_WARNING, acc,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+        TEST_ASSERT(acc[STATUS_ID_WARN_CAN_LOAD_HIGH] == 10u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Reading flushes the open interval of an active ID without double counting.
+ */
+static void
+test_read_flushes_active_ids(void)
+{
+        setUp();
+
+        status_time_t acc[NUM_STATUS_BANKS * NUM_STATUS_BITS];
+
+        status_set_info(STATUS_ID_INFO_CAN_ACTIVE);
+        status_test_clock += 20u;
+        status_time_in_state(STATUS_CLASS_INFO, acc,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+        TEST_ASSERT(acc[STATUS_ID_INFO_CAN_ACTIVE] == 20u);
+
+        status_test_clock += 30u;
+        status_time_in_state(STATUS_CLASS_INFO, acc,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+        TEST_ASSERT(acc[STATUS_ID_INFO_CAN_ACTIVE] == 50u);
+
+        status_test_clock += 5u;
+        status_clear_info(STATUS_ID_INFO_CAN_ACTIVE);
+        status_test_clock += 500u;
+        status_time_in_state(STATUS_CLASS_INFO, acc,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+        TEST_ASSERT(acc[STATUS_ID_INFO_CAN_ACTIVE] == 55u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * status_clear_all closes every open interval in the class.
+ */
+static void
+test_clear_all_closes_intervals(void)
+{
+        setUp();
+
+        status_time_t acc[NUM_STATUS_BANKS * NUM_STATUS_BITS];
+
+        status_set_fault(STATUS_ID_FAULT_OVERCURRENT);
+        status_set_fault(STATUS_ID_FAULT_CAN_TIMEOUT);
+        status_test_clock += 40u;
+        status_clear_all(STATUS_CLASS_FAULT);
+        status_test_clock += 40u;
+
+        status_time_in_state(STATUS_CLASS_FAULT, acc,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+        TEST_ASSERT(acc[STATUS_ID_FAULT_OVERCURRENT] == 40u);
+        TEST_ASSERT(acc[STATUS_ID_FAULT_CAN_TIMEOUT] == 40u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Intervals spanning a clock wrap are measured correctly; status_init resets.
+ */
+static void
+test_wrap_and_init_reset(void)
+{
+        setUp();
+
+        status_time_t acc[NUM_STATUS_BANKS * NUM_STATUS_BITS];
+
+        status_test_clock = 0xFFFFFFF0u;
+        status_set_fault(STATUS_ID_FAULT_DC_BUS_FAULT);
+        status_test_clock = 0x10u;
+        status_clear_fault(STATUS_ID_FAULT_DC_BUS_FAULT);
+
+        status_time_in_state(STATUS_CLASS_FAULT, acc,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+        TEST_ASSERT(acc[STATUS_ID_FAULT_DC_BUS_FAULT] == 0x20u);
+
+        status_init();
+        status_time_in_state(STATUS_CLASS_FAULT, acc,
+                             NUM_STATUS_BANKS * NUM_STATUS_BITS);
+        TEST_ASSERT(acc[STATUS_ID_FAULT_DC_BUS_FAULT] == 0u);
+
+        TEST_PASS(__func__);
+}
+
+/*
+ * Partial reads copy a prefix; invalid arguments report errors.
+ */
+static void
+test_bulk_read_arguments(void)
+{
+        setUp();
+
+        status_time_t acc[4] = {99u, 99u, 99u, 99u};
+
+        status_set_fault(STATUS_ID_FAULT_OVERVOLTAGE);
+        status_test_clock += 3u;
+        status_time_in_state(STATUS_CLASS_FAULT, acc, 2u);
+        TEST_ASSERT(acc[1] == 3u);
+        TEST_ASSERT(acc[2] == 99u);
+
+        status_time_in_state(STATUS_CLASS_FAULT, NULL, 2u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_NULL_PTR);
+        status_time_in_state(STATUS_CLASS_FAULT, acc, 0u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_LEN);
+        status_time_in_state((enum status_class)99, acc, 2u);
+        TEST_ASSERT(g_last_err == STATUS_ERR_INVALID_ID);
+        TEST_ASSERT(g_err_count == 3u);
+
+        TEST_PASS(__func__);
+}
+
+int
+main(void)
+{
+        test_accumulates_closed_intervals();
+        test_repeated_set_is_not_an_edge();
+        test_read_flushes_active_ids();
+        test_clear_all_closes_intervals();
+        test_wrap_and_init_reset();
+        test_bulk_read_arguments();
+
+        fprintf(stdout, "\nAll tests passed.\n");
+        return EXIT_SUCCESS;
+}
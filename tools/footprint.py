@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+# @copyright MIT
+#
+# @file: footprint.py
+#
+# @brief Report the flash/RAM cost of the library across configurations.
+#
+# Compiles the library sources once per (NUM_STATUS_BANKS, feature set)
+# combination and sums the section sizes of the objects the way Berkeley
+# `size` does:
+#
+#   text  allocated, read-only sections (code and constant data)
+#   data  allocated, writable sections with contents
+#   bss   allocated, writable sections without contents
+#
+# Sizes are read straight from the ELF objects, so any ELF cross compiler
+# works and binutils are not needed. Critical sections are compiled as
+# no-ops; add the cost of your own macros on top.
+#
+# Usage (normally via `meson compile -C build footprint`):
+#
+#     footprint.py --cc "arm-none-eabi-gcc -mcpu=cortex-m4" --source-root . \
+#                  --json footprint.json [--banks 1,12,64] [--cflags "-Os"]
+
+import argparse
+import json
+import os
+import shlex
+import struct
+import subprocess
+import sys
+import tempfile
+
+SOURCES = ("src/status.c", "src/status_deadline.c", "src/status_export.c",
+           "src/status_history.c", "src/status_replay.c")
+
+# name -> extra defines; "base" is the default build.
+FEATURES = (
+    ("base", ()),
+    ("time", ("STATUS_ENABLE_TIME_IN_STATE",)),
+    ("hist", ("STATUS_ENABLE_HISTOGRAM",)),
+    ("prio", ("STATUS_ENABLE_PRIORITY",)),
+    ("meta", ("STATUS_ENABLE_META",)),
+    ("integrity", ("STATUS_ENABLE_INTEGRITY",)),
+    ("shadow", ("STATUS_ENABLE_SHADOW",)),
+    ("sources", ("STATUS_ENABLE_SOURCES",)),
+    ("alloc", ("STATUS_ENABLE_BANK_ALLOC", "STATUS_ENABLE_BANK_OWNERS")),
+    ("dirty", ("STATUS_ENABLE_DIRTY",)),
+    ("edge", ("STATUS_ENABLE_EDGE_HOOK",)),
+    ("all", ("STATUS_ENABLE_TIME_IN_STATE", "STATUS_ENABLE_HISTOGRAM",
+             "STATUS_ENABLE_PRIORITY", "STATUS_ENABLE_META",
+             "STATUS_ENABLE_INTEGRITY", "STATUS_ENABLE_SHADOW",
+             "STATUS_ENABLE_SOURCES", "STATUS_ENABLE_BANK_ALLOC",
+             "STATUS_ENABLE_BANK_OWNERS", "STATUS_ENABLE_DIRTY",
+             "STATUS_ENABLE_EDGE_HOOK")),
+)
+
+CONFIG_HEADER = """\
+/* Generated by footprint.py: platform hooks for size measurement. */
+#include <stdint.h>
+extern volatile uint32_t status_footprint_clock;
+#define STATUS_ENTER_CRITICAL()
+#define STATUS_EXIT_CRITICAL()
+#define STATUS_TIME_NOW() (status_footprint_clock)
+"""
+
+SHF_WRITE = 0x1
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+
+class FootprintError(Exception):
+    pass
+
+
+def elf_sizes(path):
+    """Return (text, data, bss) of an ELF object."""
+    with open(path, "rb") as f:
+        img = f.read()
+    if img[:4] != b"\x7fELF":
+        raise FootprintError(f"{path}: not an ELF object")
+    is64 = img[4] == 2
+    end = "<" if img[5] == 1 else ">"
+    if is64:
+        shoff, = struct.unpack_from(end + "Q", img, 0x28)
+        shentsize, shnum = struct.unpack_from(end + "HH", img, 0x3A)
+        shfmt = end + "IIQQQQ"
+    else:
+        shoff, = struct.unpack_from(end + "I", img, 0x20)
+        shentsize, shnum = struct.unpack_from(end + "HH", img, 0x2E)
+        shfmt = end + "IIIIII"
+
+    text = data = bss = 0
+    for i in range(shnum):
+        _, sh_type, flags, _, _, size = struct.unpack_from(
+            shfmt, img, shoff + (i * shentsize))
+        if not flags & SHF_ALLOC:
+            continue
+        if sh_type == SHT_NOBITS:
+            bss += size
+        elif flags & SHF_WRITE:
+            data += size
+        else:
+            text += size
+    return text, data, bss
+
+
+def measure(cc, cflags, root, workdir, banks, defines):
+    """Compile every source for one configuration and total its sizes."""
+    total = [0, 0, 0]
+    files = {}
+    for src in SOURCES:
+        obj = os.path.join(workdir, os.path.basename(src) + ".o")
+        cmd = cc + cflags + [
+            "-c", os.path.join(root, src), "-o", obj,
+            "-I", os.path.join(root, "include"),
+            "-include", os.path.join(workdir, "footprint_config.h"),
+            f"-DNUM_STATUS_BANKS={banks}u",
+        ] + [f"-D{d}=1" for d in defines]
+        proc = subprocess.run(cmd, capture_output=True, text=True)
+        if proc.returncode != 0:
+            raise FootprintError(f"{shlex.join(cmd)}\n{proc.stderr}")
+        sizes = elf_sizes(obj)
+        files[os.path.basename(src)] = dict(zip(("text", "data", "bss"),
+                                                sizes))
+        total = [a + b for a, b in zip(total, sizes)]
+    return total, files
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("--cc", default=os.environ.get("CC", "cc"),
+                    help="C compiler command (default: $CC or cc)")
+    ap.add_argument("--cflags", default="-Os",
+                    help="compiler flags (default: -Os)")
+    ap.add_argument("--source-root", default=".",
+                    help="repository root")
+    ap.add_argument("--banks", default="1,12,64,256",
+                    help="comma-separated NUM_STATUS_BANKS values")
+    ap.add_argument("--json", help="also write the report to this file")
+    args = ap.parse_args(argv)
+
+    cc = shlex.split(args.cc)
+    cflags = ["-std=c11"] + shlex.split(args.cflags)
+    rows = []
+
+    try:
+        banks = [int(b, 0) for b in args.banks.split(",")]
+        with tempfile.TemporaryDirectory() as workdir:
+            with open(os.path.join(workdir, "footprint_config.h"), "w") as f:
+                f.write(CONFIG_HEADER)
+            for n in banks:
+                for name, defines in FEATURES:
+                    (text, data, bss), files = measure(
+                        cc, cflags, args.source_root, workdir, n, defines)
+                    rows.append({"banks": n, "features": name, "text": text,
+                                 "data": data, "bss": bss, "files": files})
+    except (FootprintError, ValueError, OSError) as err:
+        print(f"footprint: {err}", file=sys.stderr)
+        return 1
+
+    print(f"{'banks':>6} {'features':<10} {'text':>7} {'data':>6} "
+          f"{'bss':>7} {'total':>7}")
+    for r in rows:
+        print(f"{r['banks']:>6} {r['features']:<10} {r['text']:>7} "
+              f"{r['data']:>6} {r['bss']:>7} "
+              f"{r['text'] + r['data'] + r['bss']:>7}")
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"compiler": args.cc, "cflags": args.cflags,
+                       "configurations": rows}, f, indent=2)
+            f.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
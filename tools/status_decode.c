@@ -0,0 +1,455 @@
+/*
+ * @copyright MIT
+ *
+ * @file: status_decode.c
+ *
+ * @brief Host tool: decode register dumps and flight recordings.
+ *
+ * @details
+ *    usage: status_decode [-n defs.csv] [-b banks] [-o offset] [-q] FILE
+ *
+ *    FILE is one of
+ *      - a dump image (status_dump_header, see status_record.h),
+ *      - a flight recording (status_rec_header + records),
+ *      - a raw memory dump: at `offset`, u16 fault_banks[banks],
+ *        warning_banks[banks], info_banks[banks] and optionally the three
+ *        u16 last-set IDs, little-endian.
+ *
+ *    Names come from the CSV definition read by tools/status_gen.py.
+ *    Recordings are mapped read-only and decoded in a single pass; pages
+ *    already decoded are dropped, so memory use stays constant whatever the
+ *    file size. Exit status is 2 if a checkpoint does not match the replayed
+ *    state.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+/* ================ INCLUDES ================================================ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "status_record.h"
+
+/* ================ DEFINES ================================================= */
+
+#define NUM_CLASSES   (3u)
+#define BITS_PER_BANK (16u)
+#define MAX_BANKS     (4095u)
+#define MAX_IDS       (MAX_BANKS * BITS_PER_BANK)
+#define UNSET_ID      (0xFFFFu)
+
+/* Decoded pages are released in windows of this size. */
+#define DROP_WINDOW ((size_t)16u << 20u)
+
+/* ================ STATIC VARIABLES ======================================== */
+
+static const char *const class_name[NUM_CLASSES] = {"fault", "warning",
+                                                    "info"};
+
+/* ID-to-name per class, from the CSV definition (may stay NULL). */
+static char **names[NUM_CLASSES];
+
+static uint16_t banks[NUM_CLASSES][MAX_BANKS];
+static uint16_t last_id[NUM_CLASSES] = {UNSET_ID, UNSET_ID, UNSET_ID};
+static unsigned num_banks = 12u;
+static bool quiet;
+
+/* ================ STATIC FUNCTIONS ======================================== */
+
+static void
+usage(void)
+{
+        fprintf(stderr, "usage: status_decode [-n defs.csv] [-b banks] "
+                        "[-o offset] [-q] FILE\n");
+}
+
+static int
+class_from_str(const char *s)
+{
+        if (strcmp(s, "fault") == 0) {
+                return 0;
+        }
+        if ((strcmp(s, "warning") == 0) || (strcmp(s, "warn") == 0)) {
+                return 1;
+        }
+        if (strcmp(s, "info") == 0) {
+                return 2;
+        }
+        return -1;
+}
+
+/* Trim leading and trailing blanks in place. */
+static char *
+trim(char *s)
+{
+        char *end;
+
+        while ((*s == ' ') || (*s == '\t')) {
+                ++s;
+        }
+        end = s + strlen(s);
+        while ((end > s)
+               && ((end[-1] == ' ') || (end[-1] == '\t') || (end[-1] == '\r')
+                   || (end[-1] == '\n'))) {
+                *--end = '\0';
+        }
+        return s;
+}
+
+/* Read class,name,bank,bit[,...] lines of a status definition. */
+static int
+load_names(const char *path)
+{
+        FILE *f = fopen(path, "r");
+        char line[512];
+        unsigned lineno = 0u;
+
+        if (f == NULL) {
+                fprintf(stderr, "%s: %s\n", path, strerror(errno));
+                return -1;
+        }
+        for (unsigned c = 0u; c < NUM_CLASSES; ++c) {
+                names[c] = calloc(MAX_IDS, sizeof(*names[c]));
+                if (names[c] == NULL) {
+                        fclose(f);
+                        return -1;
+                }
+        }
+
+        while (fgets(line, sizeof(line), f) != NULL) {
+                char *field[4];
+                char *p = line;
+                unsigned n = 0u;
+
+                ++lineno;
+                p = trim(p);
+                if ((*p == '\0') || (*p == '#')) {
+                        continue;
+                }
+                while ((n < 4u) && (p != NULL)) {
+                        char *comma = strchr(p, ',');
+
+                        if (comma != NULL) {
+                                *comma = '\0';
+                        }
+                        field[n++] = trim(p);
+                        p = (comma != NULL) ? (comma + 1) : NULL;
+                }
+                if (strcmp(field[0], "class") == 0) {
+                        continue;
+                }
+                int cls = (n == 4u) ? class_from_str(field[0]) : -1;
+                char *e1;
+                char *e2;
+                unsigned long bank = (n == 4u) ? strtoul(field[2], &e1, 0) : 0;
+                unsigned long bit = (n == 4u) ? strtoul(field[3], &e2, 0) : 0;
+
+                if ((cls < 0) || (*e1 != '\0') || (*e2 != '\0')
+                    || (bank >= MAX_BANKS) || (bit >= BITS_PER_BANK)) {
+                        fprintf(stderr, "%s:%u: malformed definition\n", path,
+                                lineno);
+                        fclose(f);
+                        return -1;
+                }
+                free(names[cls][(bank * BITS_PER_BANK) + bit]);
+                names[cls][(bank * BITS_PER_BANK) + bit] = strdup(field[1]);
+        }
+
+        fclose(f);
+        return 0;
+}
+
+static const char *
+name_of(unsigned cls, uint16_t id)
+{
+        const char *n = NULL;
+
+        if ((names[cls] != NULL) && (id < MAX_IDS)) {
+                n = names[cls][id];
+        }
+        return (n != NULL) ? n : "?";
+}
+
+static void
+print_state(void)
+{
+        for (unsigned c = 0u; c < NUM_CLASSES; ++c) {
+                unsigned active = 0u;
+
+                for (unsigned b = 0u; b < num_banks; ++b) {
+                        active += (unsigned)__builtin_popcount(banks[c][b]);
+                }
+                printf("%s: %u active\n", class_name[c], active);
+                for (unsigned b = 0u; b < num_banks; ++b) {
+                        uint16_t m = banks[c][b];
+
+                        while (m != 0u) {
+                                const unsigned bit =
+                                    (unsigned)__builtin_ctz(m);
+                                const uint16_t id =
+                                    (uint16_t)((b * BITS_PER_BANK) + bit);
+
+                                printf("  %4u:%-2u  %s\n", b, bit,
+                                       name_of(c, id));
+                                m &= (uint16_t)(m - 1u);
+                        }
+                }
+        }
+        for (unsigned c = 0u; c < NUM_CLASSES; ++c) {
+                if (last_id[c] == UNSET_ID) {
+                        printf("last %s: none\n", class_name[c]);
+                } else {
+                        printf("last %s: %u:%u %s\n", class_name[c],
+                               last_id[c] / BITS_PER_BANK,
+                               last_id[c] % BITS_PER_BANK,
+                               name_of(c, last_id[c]));
+                }
+        }
+}
+
+static bool
+set_num_banks(unsigned n)
+{
+        if ((n == 0u) || (n > MAX_BANKS)) {
+                fprintf(stderr, "bank count %u outside 1..%u\n", n, MAX_BANKS);
+                return false;
+        }
+        num_banks = n;
+        return true;
+}
+
+/* Banks and optional trackers, as laid out in a dump or raw image. */
+static int
+decode_image(const uint8_t *p, size_t len)
+{
+        const size_t need = (size_t)NUM_CLASSES * num_banks * 2u;
+
+        if (len < need) {
+                fprintf(stderr, "image too short: %zu bytes, need %zu for "
+                                "%u banks\n",
+                        len, need, num_banks);
+                return 1;
+        }
+        for (unsigned c = 0u; c < NUM_CLASSES; ++c) {
+                for (unsigned b = 0u; b < num_banks; ++b) {
+                        banks[c][b] = status_le16_get(p);
+                        p += 2;
+                }
+        }
+        if (len >= (need + (NUM_CLASSES * 2u))) {
+                for (unsigned c = 0u; c < NUM_CLASSES; ++c) {
+                        last_id[c] = status_le16_get(p);
+                        p += 2;
+                }
+        }
+        print_state();
+        return 0;
+}
+
+static int
+decode_dump(const uint8_t *p, size_t len)
+{
+        if (status_le16_get(&p[4]) != STATUS_REC_VERSION) {
+                fprintf(stderr, "unsupported dump version %u\n",
+                        status_le16_get(&p[4]));
+                return 1;
+        }
+        if (!set_num_banks(status_le16_get(&p[6]))) {
+                return 1;
+        }
+        return decode_image(&p[STATUS_DUMP_HDR_SIZE],
+                            len - STATUS_DUMP_HDR_SIZE);
+}
+
+static uint32_t
+state_hash(void)
+{
+        uint32_t h = STATUS_REC_HASH_INIT;
+
+        for (unsigned c = 0u; c < NUM_CLASSES; ++c) {
+                h = status_record_hash(banks[c], num_banks, h);
+        }
+        return h;
+}
+
+static int
+decode_recording(const uint8_t *map, size_t len)
+{
+        const size_t rec_size = status_le32_get(&map[8]);
+        unsigned long long events = 0u;
+        unsigned long long bad = 0u;
+        unsigned long long checkpoints = 0u;
+        unsigned long long mismatches = 0u;
+        const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+        const uint8_t *drop = (const uint8_t *)((uintptr_t)map & ~(page - 1u));
+
+        if (status_le16_get(&map[4]) != STATUS_REC_VERSION) {
+                fprintf(stderr, "unsupported recording version %u\n",
+                        status_le16_get(&map[4]));
+                return 1;
+        }
+        if (!set_num_banks(status_le16_get(&map[6]))
+            || (rec_size < STATUS_REC_SIZE)) {
+                fprintf(stderr, "bad recording header\n");
+                return 1;
+        }
+
+        for (size_t off = STATUS_REC_HDR_SIZE; (len - off) >= rec_size;
+             off += rec_size) {
+                struct status_record r;
+
+                status_record_unpack(&r, &map[off]);
+                ++events;
+
+                if (r.op == STATUS_REC_CHECKPOINT) {
+                        const uint32_t h = state_hash();
+
+                        ++checkpoints;
+                        if (h != r.value) {
+                                ++mismatches;
+                                printf("%10u  CHECKPOINT MISMATCH recorded "
+                                       "%08x replayed %08x\n",
+                                       r.time, r.value, h);
+                        } else if (!quiet) {
+                                printf("%10u  checkpoint ok\n", r.time);
+                        }
+                } else if ((r.cls >= NUM_CLASSES)
+                           || ((r.op != STATUS_REC_CLEAR_ALL)
+                               && ((r.id / BITS_PER_BANK) >= num_banks))) {
+                        ++bad;
+                        printf("%10u  invalid record (cls %u op %u id %u)\n",
+                               r.time, r.cls, r.op, r.id);
+                } else {
+                        const unsigned b = r.id / BITS_PER_BANK;
+                        const uint16_t m =
+                            (uint16_t)(1u << (r.id % BITS_PER_BANK));
+                        const char *op = "?";
+
+                        switch (r.op) {
+                        case STATUS_REC_SET:
+                                banks[r.cls][b] |= m;
+                                last_id[r.cls] = r.id;
+                                op = "set";
+                                break;
+                        case STATUS_REC_CLEAR:
+                                banks[r.cls][b] &= (uint16_t)~m;
+                                op = "clear";
+                                break;
+                        case STATUS_REC_CLEAR_ALL:
+                                memset(banks[r.cls], 0,
+                                       num_banks * sizeof(banks[0][0]));
+                                op = "clear_all";
+                                break;
+                        default: ++bad; break;
+                        }
+                        if (!quiet) {
+                                if (r.op == STATUS_REC_CLEAR_ALL) {
+                                        printf("%10u  %-9s %s\n", r.time, op,
+                                               class_name[r.cls]);
+                                } else {
+                                        printf("%10u  %-9s %-7s %4u:%-2u  "
+                                               "%s\n",
+                                               r.time, op, class_name[r.cls],
+                                               b, r.id % BITS_PER_BANK,
+                                               name_of(r.cls, r.id));
+                                }
+                        }
+                }
+
+                /* Give decoded pages back so RSS stays bounded. */
+                if ((size_t)(&map[off] - drop) >= (2u * DROP_WINDOW)) {
+                        madvise((void *)drop, DROP_WINDOW, MADV_DONTNEED);
+                        drop += DROP_WINDOW;
+                }
+        }
+
+        printf("-- %llu records, %llu invalid, %llu checkpoints, "
+               "%llu mismatches\n",
+               events, bad, checkpoints, mismatches);
+        print_state();
+
+        return (mismatches != 0u) ? 2 : ((bad != 0u) ? 1 : 0);
+}
+
+/* ================ GLOBAL FUNCTIONS ======================================== */
+
+int
+main(int argc, char **argv)
+{
+        const char *defs = NULL;
+        unsigned long offset = 0u;
+        int opt;
+        int rc;
+
+        while ((opt = getopt(argc, argv, "n:b:o:qh")) != -1) {
+                switch (opt) {
+                case 'n': defs = optarg; break;
+                case 'b':
+                        if (!set_num_banks((unsigned)strtoul(optarg, NULL, 0))) {
+                                return 1;
+                        }
+                        break;
+                case 'o': offset = strtoul(optarg, NULL, 0); break;
+                case 'q': quiet = true; break;
+                default: usage(); return (opt == 'h') ? 0 : 1;
+                }
+        }
+        if (optind != (argc - 1)) {
+                usage();
+                return 1;
+        }
+        if ((defs != NULL) && (load_names(defs) != 0)) {
+                return 1;
+        }
+
+        int fd = open(argv[optind], O_RDONLY);
+        struct stat st;
+
+        if ((fd < 0) || (fstat(fd, &st) != 0)) {
+                fprintf(stderr, "%s: %s\n", argv[optind], strerror(errno));
+                return 1;
+        }
+        const size_t len = (size_t)st.st_size;
+        if ((len == 0u) || (offset >= len)) {
+                fprintf(stderr, "%s: empty or offset beyond end\n",
+                        argv[optind]);
+                close(fd);
+                return 1;
+        }
+
+        const uint8_t *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) {
+                fprintf(stderr, "%s: mmap: %s\n", argv[optind],
+                        strerror(errno));
+                return 1;
+        }
+        madvise((void *)map, len, MADV_SEQUENTIAL);
+
+        const uint8_t *p = map + offset;
+        const size_t avail = len - offset;
+        const uint32_t magic = (avail >= 4u) ? status_le32_get(p) : 0u;
+
+        if ((magic == STATUS_REC_MAGIC) && (avail >= STATUS_REC_HDR_SIZE)) {
+                rc = decode_recording(p, avail);
+        } else if ((magic == STATUS_DUMP_MAGIC)
+                   && (avail >= STATUS_DUMP_HDR_SIZE)) {
+                rc = decode_dump(p, avail);
+        } else {
+                rc = decode_image(p, avail);
+        }
+
+        munmap((void *)map, len);
+        return rc;
+}
@@ -0,0 +1,372 @@
+#!/usr/bin/env python3
+#
+# @copyright MIT
+#
+# @file: status_gen.py
+#
+# @brief Generate status_ids.h / status_ids.c from a CSV status definition.
+#
+# Input format (one status per line, '#' starts a comment, header optional):
+#
+#     class,   name,              bank, bit, rank, severity, group, flags, debounce
+#     fault,   FAULT_OVERCURRENT, 0,    0,   250,  3,        power, latch, 0
+#
+# Only class, name, bank and bit are required; the remaining columns default
+# to "unranked", 0, no group, no flags and no debounce.
+#
+# Outputs:
+#   header  STATUS_ID_* macros, group ids, per-bank group masks and
+#           query term initialisers,
+#           STATUS_<CLASS>_META(X) lists for STATUS_META_ENTRY, and
+#           declarations of the name tables.
+#   source  dense ID-to-name tables, the minimal perfect hash used for
+#           name-to-ID lookup (status_name_table, read by src/status_names.c),
+#           and (under STATUS_ENABLE_META) the
+#           status_meta_table definition.
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+CLASSES = ("fault", "warning", "info")
+CLASS_ENUM = ("STATUS_CLASS_FAULT", "STATUS_CLASS_WARNING", "STATUS_CLASS_INFO")
+META_LIST = ("STATUS_FAULT_META", "STATUS_WARN_META", "STATUS_INFO_META")
+COLUMNS = ("class", "name", "bank", "bit", "rank", "severity", "group",
+           "flags", "debounce")
+FLAGS = {"latch": "STATUS_META_LATCH"}
+NAME_RE = re.compile(r"^[A-Z][A-Z0-9_]*$")
+MAX_BANKS = 4095
+MAX_DISP = 0xFFFF
+
+
+class DefinitionError(Exception):
+    pass
+
+
+def name_hash(s, seed):
+    """Mirror of status_name_hash() in include/status_names.h."""
+    h = 2166136261 ^ seed
+    for c in s.encode("ascii"):
+        h ^= c
+        h = (h * 16777619) & 0xFFFFFFFF
+    h ^= h >> 15
+    h = (h * 0x2C1B3C6D) & 0xFFFFFFFF
+    h ^= h >> 12
+    return h
+
+
+def parse_int(text, what, lineno, lo, hi):
+    try:
+        value = int(text, 0)
+    except ValueError:
+        raise DefinitionError(f"line {lineno}: {what} '{text}' is not a number")
+    if not lo <= value <= hi:
+        raise DefinitionError(
+            f"line {lineno}: {what} {value} outside {lo}..{hi}")
+    return value
+
+
+def read_definitions(path):
+    entries = []
+    seen_names = {}
+    seen_ids = {}
+    seen_ranks = {}
+
+    with open(path, newline="") as f:
+        for lineno, row in enumerate(csv.reader(f), start=1):
+            row = [c.strip() for c in row]
+            if not row or not row[0] or row[0].startswith("#"):
+                continue
+            if row[0].lower() == "class":
+                continue  # header
+            if len(row) < 4 or len(row) > len(COLUMNS):
+                raise DefinitionError(
+                    f"line {lineno}: expected 4..{len(COLUMNS)} columns")
+            row += [""] * (len(COLUMNS) - len(row))
+            rec = dict(zip(COLUMNS, row))
+
+            cls = rec["class"].lower()
+            if cls == "warn":
+                cls = "warning"
+            if cls not in CLASSES:
+                raise DefinitionError(
+                    f"line {lineno}: unknown class '{rec['class']}'")
+            name = rec["name"]
+            if not NAME_RE.match(name):
+                raise DefinitionError(
+                    f"line {lineno}: invalid name '{name}'")
+            if name in seen_names:
+                raise DefinitionError(
+                    f"line {lineno}: duplicate name '{name}' "
+                    f"(first on line {seen_names[name]})")
+            bank = parse_int(rec["bank"], "bank", lineno, 0, MAX_BANKS - 1)
+            bit = parse_int(rec["bit"], "bit", lineno, 0, 15)
+            key = (cls, bank, bit)
+            if key in seen_ids:
+                raise DefinitionError(
+                    f"line {lineno}: {cls} bank {bank} bit {bit} already "
+                    f"used on line {seen_ids[key]}")
+            rank = None
+            if rec["rank"]:
+                rank = parse_int(rec["rank"], "rank", lineno, 0, 1023)
+                if (cls, rank) in seen_ranks:
+                    raise DefinitionError(
+                        f"line {lineno}: {cls} rank {rank} already used on "
+                        f"line {seen_ranks[(cls, rank)]}")
+                seen_ranks[(cls, rank)] = lineno
+            flags = []
+            for flag in filter(None, rec["flags"].lower().split("|")):
+                if flag not in FLAGS:
+                    raise DefinitionError(
+                        f"line {lineno}: unknown flag '{flag}'")
+                flags.append(FLAGS[flag])
+
+            seen_names[name] = lineno
+            seen_ids[key] = lineno
+            entries.append({
+                "cls": CLASSES.index(cls),
+                "name": name,
+                "bank": bank,
+                "bit": bit,
+                "id": (bank << 4) | bit,
+                "rank": rank,
+                "severity": parse_int(rec["severity"] or "0", "severity",
+                                      lineno, 0, 255),
+                "group": rec["group"].lower(),
+                "flags": flags,
+                "debounce": parse_int(rec["debounce"] or "0", "debounce",
+                                      lineno, 0, 255),
+            })
+
+    if not entries:
+        raise DefinitionError("no status definitions found")
+    return entries
+
+
+def build_perfect_hash(names):
+    """CHD-style minimal perfect hash: bucket = h(s, 0) % nb, and each bucket
+    gets the smallest displacement d >= 1 such that h(s, d) % n places all of
+    its keys in distinct free slots."""
+    n = len(names)
+    nb = max(1, (n + 1) // 2)
+    buckets = [[] for _ in range(nb)]
+    for s in names:
+        buckets[name_hash(s, 0) % nb].append(s)
+
+    disp = [0] * nb
+    slots = [None] * n
+    order = sorted(range(nb), key=lambda b: len(buckets[b]), reverse=True)
+    for b in order:
+        keys = buckets[b]
+        if not keys:
+            continue
+        for d in range(1, MAX_DISP + 1):
+            idx = [name_hash(s, d) % n for s in keys]
+            if len(set(idx)) == len(idx) and all(slots[i] is None
+                                                 for i in idx):
+                for s, i in zip(keys, idx):
+                    slots[i] = s
+                disp[b] = d
+                break
+        else:
+            raise DefinitionError("could not build a perfect hash; "
+                                  "rename a status or split the table")
+    return disp, slots
+
+
+def guard_for(path):
+    base = os.path.basename(path)
+    return re.sub(r"[^A-Za-z0-9]", "_", base).upper()
+
+
+def meta_line(e):
+    rank = f"{e['rank']}u" if e["rank"] is not None else "STATUS_PRIO_NONE"
+    flags = " | ".join(e["flags"]) if e["flags"] else "0u"
+    return (f"X(STATUS_ID_{e['name']}, {rank}, {e['severity']}u, "
+            f"{e['group_id']}u, {flags}, {e['debounce']}u)")
+
+
+def emit_header(entries, groups, num_banks, src_name, header_path):
+    guard = guard_for(header_path)
+    out = []
+    w = out.append
+
+    w(f"/*\n * @file: {os.path.basename(header_path)}\n"
+      f" * @brief Status IDs generated from {src_name}.\n"
+      " *\n * @note Generated by tools/status_gen.py. Do not edit.\n */\n")
+    w(f"#ifndef {guard}\n#define {guard}\n")
+    w('#include "status.h"\n#include "status_names.h"\n')
+    w("/* Banks used by the definition; NUM_STATUS_BANKS must cover them. */")
+    w(f"#define STATUS_GEN_NUM_BANKS ({num_banks}u)\n")
+    w(f"#if NUM_STATUS_BANKS < {num_banks}")
+    w(f'#error "NUM_STATUS_BANKS is smaller than the banks used in {src_name}"')
+    w("#endif\n")
+
+    for c, cls in enumerate(CLASSES):
+        rows = [e for e in entries if e["cls"] == c]
+        if not rows:
+            continue
+        w(f"/* ---------------------- {cls.capitalize()} IDs */\n")
+        width = max(len(e["name"]) for e in rows) + len("STATUS_ID_")
+        for e in rows:
+            macro = f"STATUS_ID_{e['name']}".ljust(width)
+            w(f"#define {macro} STATUS_ENCODE({e['bank']}u, {e['bit']}u)")
+        w("")
+
+    if groups:
+        w("/* ---------------------- Groups */\n")
+        w("/* Group numbers as stored in status_meta.group. */")
+        for g, gid in groups.items():
+            w(f"#define STATUS_GROUP_{g.upper()} ({gid}u)")
+        w("")
+        w("/* Per-bank member masks: STATUS_GROUP_<group>_<class>_B<bank>. */")
+        for g in groups:
+            for c, cls in enumerate(CLASSES):
+                masks = {}
+                for e in entries:
+                    if e["cls"] == c and e["group"] == g:
+                        masks[e["bank"]] = masks.get(e["bank"], 0) | (
+                            1 << e["bit"])
+                for bank in sorted(masks):
+                    w(f"#define STATUS_GROUP_{g.upper()}_{cls.upper()}_B{bank} "
+                      f"(0x{masks[bank]:04X}u)")
+        w("")
+        w("/* Query term initialisers: STATUS_GROUP_<group>_<class>_TERMS. */")
+        for g in groups:
+            for c, cls in enumerate(CLASSES):
+                banks = sorted({e["bank"] for e in entries
+                                if e["cls"] == c and e["group"] == g})
+                if not banks:
+                    continue
+                terms = ", ".join(
+                    f"STATUS_QUERY_TERM({b}u, "
+                    f"STATUS_GROUP_{g.upper()}_{cls.upper()}_B{b})"
+                    for b in banks)
+                w(f"#define STATUS_GROUP_{g.upper()}_{cls.upper()}_TERMS "
+                  f"{{{terms}}}")
+        w("")
+
+    w("/* ---------------------- Metadata lists (STATUS_META_ENTRY) */\n")
+    for c in range(len(CLASSES)):
+        rows = [e for e in entries if e["cls"] == c]
+        if not rows:
+            w(f"#define {META_LIST[c]}(X)\n")
+            continue
+        w(f"#define {META_LIST[c]}(X) \\")
+        for i, e in enumerate(rows):
+            tail = " \\" if i + 1 < len(rows) else ""
+            w(f"        {meta_line(e)}{tail}")
+        w("")
+
+    w("/* ---------------------- Name tables */\n")
+    w("/* Dense ID-to-name table per class; NULL for undefined IDs. */")
+    w("#define STATUS_NAMES_LEN (STATUS_GEN_NUM_BANKS * NUM_STATUS_BITS)")
+    w("extern const char *const status_names[3][STATUS_NAMES_LEN];\n")
+    w("/* Minimal perfect hash over every name (see status_name_hash()). */")
+    w(f"#define STATUS_NAME_COUNT ({len(entries)}u)")
+    w(f"#define STATUS_NAME_BUCKETS ({max(1, (len(entries) + 1) // 2)}u)")
+    w("extern const uint16_t status_name_disp[STATUS_NAME_BUCKETS];")
+    w("extern const struct status_name_entry "
+      "status_name_slots[STATUS_NAME_COUNT];\n")
+    w(f"#endif /* {guard} */")
+    return "\n".join(out) + "\n"
+
+
+def emit_source(entries, disp, slots, src_name, header_path, source_path):
+    by_name = {e["name"]: e for e in entries}
+    out = []
+    w = out.append
+
+    w(f"/*\n * @file: {os.path.basename(source_path)}\n"
+      f" * @brief Name tables generated from {src_name}.\n"
+      " *\n * @note Generated by tools/status_gen.py. Do not edit.\n */\n")
+    w(f'#include "{os.path.basename(header_path)}"\n')
+
+    w("const char *const status_names[3][STATUS_NAMES_LEN] = {")
+    for c in range(len(CLASSES)):
+        rows = [e for e in entries if e["cls"] == c]
+        if not rows:
+            continue
+        w(f"        [{CLASS_ENUM[c]}] = {{")
+        for e in rows:
+            w(f'                [STATUS_ID_{e["name"]}] = "{e["name"]}",')
+        w("        },")
+    w("};\n")
+
+    w("const uint16_t status_name_disp[STATUS_NAME_BUCKETS] = {")
+    for i in range(0, len(disp), 8):
+        w("        " + " ".join(f"{d}u," for d in disp[i:i + 8]))
+    w("};\n")
+
+    w("const struct status_name_entry status_name_slots[STATUS_NAME_COUNT] = {")
+    for s in slots:
+        e = by_name[s]
+        w(f'        {{"{s}", STATUS_ID_{s}, (uint8_t){CLASS_ENUM[e["cls"]]}}},')
+    w("};\n")
+
+    w("const struct status_name_map status_name_table = {")
+    w("        .names = {status_names[0], status_names[1], status_names[2]},")
+    w("        .names_len = STATUS_NAMES_LEN,")
+    w("        .disp = status_name_disp,")
+    w("        .buckets = STATUS_NAME_BUCKETS,")
+    w("        .slots = status_name_slots,")
+    w("        .count = STATUS_NAME_COUNT,")
+    w("};\n")
+
+    w("#if STATUS_ENABLE_META")
+    w("const struct status_meta status_meta_table[3][STATUS_META_LEN] = {")
+    for c in range(len(CLASSES)):
+        if any(e["cls"] == c for e in entries):
+            w(f"        [{CLASS_ENUM[c]}] = {{{META_LIST[c]}(STATUS_META_ENTRY)}},")
+    w("};")
+    w("#endif")
+    return "\n".join(out) + "\n"
+
+
+def write_if_changed(path, text):
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("definition", help="CSV status definition")
+    ap.add_argument("header", help="output header path")
+    ap.add_argument("source", help="output C source path")
+    args = ap.parse_args(argv)
+
+    try:
+        entries = read_definitions(args.definition)
+        groups = {}
+        for e in entries:
+            if e["group"] and e["group"] not in groups:
+                if not NAME_RE.match(e["group"].upper()):
+                    raise DefinitionError(f"invalid group '{e['group']}'")
+                groups[e["group"]] = len(groups) + 1
+            e["group_id"] = groups.get(e["group"], 0)
+        num_banks = max(e["bank"] for e in entries) + 1
+        disp, slots = build_perfect_hash([e["name"] for e in entries])
+    except DefinitionError as err:
+        print(f"{args.definition}: {err}", file=sys.stderr)
+        return 1
+
+    src_name = os.path.basename(args.definition)
+    write_if_changed(args.header,
+                     emit_header(entries, groups, num_banks, src_name,
+                                 args.header))
+    write_if_changed(args.source,
+                     emit_source(entries, disp, slots, src_name, args.header,
+                                 args.source))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))